@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark/benchmark.h"
+#include "et/alloc.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+constexpr auto kObjects = std::size_t(1024);
+
+struct Node {
+  std::uint64_t key;
+  std::uint64_t value;
+  Node* next;
+};
+
+// baseline: the throwing operator new the fallible functions replace
+void BM_OperatorNew(benchmark::State& state) {
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto* const node = static_cast<Node*>(::operator new(sizeof(Node)));
+    benchmark::DoNotOptimize(node);
+    ::operator delete(node);
+  }
+}
+BENCHMARK(BM_OperatorNew);
+
+void BM_TryAllocate(benchmark::State& state) {
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const node = et::TryAllocate<Node>(1);
+    if (!node) {
+      state.SkipWithError("out of memory");
+      break;
+    }
+    benchmark::DoNotOptimize(node.Success());
+    et::Deallocate(node.Success());
+  }
+}
+BENCHMARK(BM_TryAllocate);
+
+void BM_TryMakeUnique(benchmark::State& state) {
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto node = et::TryMakeUnique<Node>();
+    benchmark::DoNotOptimize(node);
+  }
+}
+BENCHMARK(BM_TryMakeUnique);
+
+// kObjects allocations, then one Reset
+void BM_BumpAllocate(benchmark::State& state) {
+  auto created = et::BumpAllocator::Create(kObjects * sizeof(Node));
+  if (!created) {
+    std::abort();
+  }
+  auto& bump = created.Success();
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    for (auto i = std::size_t(0); i < kObjects; ++i) {
+      auto const node = bump.Allocate<Node>();
+      benchmark::DoNotOptimize(node);
+    }
+    bump.Reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kObjects);
+}
+BENCHMARK(BM_BumpAllocate);
+
+// kObjects allocations, then their deallocations in allocation order
+void BM_PoolAllocate(benchmark::State& state) {
+  auto created = et::PoolAllocator<Node>::Create(kObjects);
+  if (!created) {
+    std::abort();
+  }
+  auto& pool = created.Success();
+  Node* nodes[kObjects];
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    for (auto i = std::size_t(0); i < kObjects; ++i) {
+      nodes[i] = pool.Allocate().Success();
+    }
+    benchmark::DoNotOptimize(nodes);
+    for (auto* const node : nodes) {
+      pool.Deallocate(node);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kObjects);
+}
+BENCHMARK(BM_PoolAllocate);
+
+}  // namespace
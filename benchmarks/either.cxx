@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "et/either.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+using Result = et::Either<std::uint64_t, std::uint32_t>;
+
+constexpr auto kBatch = std::size_t(4096);
+constexpr auto kMaxThreads = std::size_t(8);
+
+auto Compute(std::size_t const i) -> Result {
+  if (i % 16 == 0) {
+    return et::Error(static_cast<std::uint32_t>(i));
+  }
+  return et::Success(std::uint64_t(i) * 3);
+}
+
+// the shape without a default constructor: each thread appends its results
+// to a shared vector under a lock
+void BM_BatchFillLocked(benchmark::State& state) {
+  static std::mutex mutex;
+  static auto* const results = [] {
+    auto* const vector = new std::vector<Result>();
+    vector->reserve(kBatch * kMaxThreads);
+    return vector;
+  }();
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    for (auto i = std::size_t(0); i < kBatch; ++i) {
+      auto result = Compute(i);
+      std::lock_guard<std::mutex> const lock(mutex);
+      if (results->size() == results->capacity()) {
+        results->clear();
+      }
+      results->push_back(std::move(result));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kBatch));
+}
+BENCHMARK(BM_BatchFillLocked)->ThreadRange(1, kMaxThreads);
+
+// a buffer of empty results allocated up front, each thread assigning its
+// own slots
+void BM_BatchFillPreallocated(benchmark::State& state) {
+  static auto const results = std::make_unique<Result[]>(kBatch * kMaxThreads);
+  auto* const slots =
+      results.get() + static_cast<std::size_t>(state.thread_index()) * kBatch;
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    for (auto i = std::size_t(0); i < kBatch; ++i) {
+      slots[i] = Compute(i);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kBatch));
+}
+BENCHMARK(BM_BatchFillPreallocated)->ThreadRange(1, kMaxThreads);
+
+// cost of allocating the empty buffer itself: one store per slot
+void BM_EmptyBuffer(benchmark::State& state) {
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto results = std::vector<Result>(kBatch);
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kBatch));
+}
+BENCHMARK(BM_EmptyBuffer);
+
+}  // namespace
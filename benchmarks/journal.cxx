@@ -0,0 +1,58 @@
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "et/journal.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+// one journal shared by all benchmark threads, its file unlinked right away
+auto SharedJournal() -> et::Journal& {
+  static auto* const journal = [] {
+    char path[] = "/tmp/et_journal_benchXXXXXX";
+    auto const fd = ::mkstemp(path);
+    if (fd == -1) {
+      std::abort();
+    }
+    ::close(fd);
+    auto opened = et::Journal::Open(path, 1 << 16);
+    ::unlink(path);
+    if (!opened) {
+      std::abort();
+    }
+    return new et::Journal(std::move(opened).Success());
+  }();
+  return *journal;
+}
+
+void BM_JournalAppend(benchmark::State& state) {
+  auto& journal = SharedJournal();
+  auto i = std::uint64_t(0);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    journal.Append(7, (i & 15) == 0, i);
+    ++i;
+  }
+}
+BENCHMARK(BM_JournalAppend)->ThreadRange(1, 8);
+
+void BM_JournalAppendEither(benchmark::State& state) {
+  auto& journal = SharedJournal();
+  auto i = std::int64_t(0);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const outcome =
+        (i & 15) == 0 ? et::Either<std::int64_t, et::Errno>(
+                            et::Error(et::Errno(EAGAIN)))
+                      : et::Either<std::int64_t, et::Errno>(et::Success(i));
+    journal.Append(8, outcome);
+    ++i;
+  }
+}
+BENCHMARK(BM_JournalAppendEither);
+
+}  // namespace
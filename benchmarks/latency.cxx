@@ -0,0 +1,59 @@
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "et/latency.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+// out of line so the timed and untimed variants run the same call
+__attribute__((noinline)) auto Check(std::int64_t value)
+    -> et::Either<std::int64_t, std::int32_t> {
+  if (value % 16 == 0) {
+    return et::Error(static_cast<std::int32_t>(value));
+  }
+  return et::Success(value);
+}
+
+void BM_Untimed(benchmark::State& state) {
+  auto i = std::int64_t(0);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const result = Check(i++);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_Untimed)->ThreadRange(1, 8);
+
+// the difference to BM_Untimed is the per call overhead of ET_TIMED
+void BM_Timed(benchmark::State& state) {
+  static et::LatencyRecorder recorder;
+  auto i = std::int64_t(0);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const result = ET_TIMED(recorder, Check(i++));
+    benchmark::DoNotOptimize(result);
+  }
+  if (state.thread_index() == 0) {
+    auto const report = recorder.Snapshot();
+    state.counters["success_p50_ns"] =
+        report.Nanoseconds(report.success.Percentile(0.5));
+    state.counters["error_p50_ns"] =
+        report.Nanoseconds(report.error.Percentile(0.5));
+  }
+}
+BENCHMARK(BM_Timed)->ThreadRange(1, 8);
+
+void BM_Snapshot(benchmark::State& state) {
+  et::LatencyRecorder recorder;
+  recorder.Record(true, 1);
+  recorder.Record(false, 1);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const report = recorder.Snapshot();
+    benchmark::DoNotOptimize(report.success.Count());
+  }
+}
+BENCHMARK(BM_Snapshot);
+
+}  // namespace
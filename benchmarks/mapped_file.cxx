@@ -0,0 +1,134 @@
+#include <unistd.h>
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "et/mapped_file.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+constexpr auto kPageSize = std::size_t(4096);
+
+// generated once per size and removed when the benchmark binary exits
+class ReferenceFiles {
+ public:
+  ~ReferenceFiles() {
+    for (auto const& it : paths_) {
+      ::unlink(it.second.c_str());
+    }
+  }
+
+  auto Get(std::size_t size) -> std::string const& {
+    auto it = paths_.find(size);
+    if (it == paths_.end()) {
+      it = paths_.emplace(size, Generate(size)).first;
+    }
+    return it->second;
+  }
+
+ private:
+  static auto Generate(std::size_t size) -> std::string {
+    char path[] = "/tmp/et_mapped_file_benchXXXXXX";
+    auto const fd = ::mkstemp(path);
+    if (fd == -1) {
+      std::abort();
+    }
+
+    auto block = std::string(1U << 20U, '\0');
+    for (auto i = std::size_t(0); i < block.size(); ++i) {
+      block[i] = static_cast<char>('a' + i % 26);
+    }
+    for (auto written = std::size_t(0); written < size;) {
+      auto const chunk = std::min(block.size(), size - written);
+      if (!et::sys::Write(fd, block.data(), chunk)) {
+        std::abort();
+      }
+      written += chunk;
+    }
+
+    ::close(fd);
+    return path;
+  }
+
+  std::map<std::size_t, std::string> paths_;
+};
+
+auto Files() -> ReferenceFiles& {
+  static auto files = ReferenceFiles();
+  return files;
+}
+
+// touches one byte per page so both variants end up with resident data
+auto TouchPages(char const* data, std::size_t size) -> std::uint64_t {
+  auto sum = std::uint64_t(0);
+  for (auto i = std::size_t(0); i < size; i += kPageSize) {
+    sum += static_cast<unsigned char>(data[i]);
+  }
+  return sum;
+}
+
+void BM_IfstreamLoad(benchmark::State& state) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  auto const& path = Files().Get(size);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto stream = std::ifstream(path, std::ios::binary);
+    auto const content = std::string(std::istreambuf_iterator<char>(stream),
+                                     std::istreambuf_iterator<char>());
+    benchmark::DoNotOptimize(TouchPages(content.data(), content.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IfstreamLoad)
+    ->Arg(64 << 20)
+    ->Arg(256 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MappedFileOpen(benchmark::State& state) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  auto const& path = Files().Get(size);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const file = et::MappedFile::Open(path);
+    if (!file) {
+      state.SkipWithError("open failed");
+      break;
+    }
+    benchmark::DoNotOptimize(file.Success().Data());
+  }
+}
+BENCHMARK(BM_MappedFileOpen)
+    ->Arg(64 << 20)
+    ->Arg(256 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MappedFileLoad(benchmark::State& state) {
+  auto const size = static_cast<std::size_t>(state.range(0));
+  auto const& path = Files().Get(size);
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const file = et::MappedFile::Open(path);
+    if (!file) {
+      state.SkipWithError("open failed");
+      break;
+    }
+    auto const& mapped = file.Success();
+    mapped.Advise(et::MappedFile::Advice::kSequential);
+    benchmark::DoNotOptimize(TouchPages(mapped.Data(), mapped.Size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MappedFileLoad)
+    ->Arg(64 << 20)
+    ->Arg(256 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
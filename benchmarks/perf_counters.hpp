@@ -0,0 +1,156 @@
+#ifndef ET_BENCHMARKS_PERF_COUNTERS_HPP_
+#define ET_BENCHMARKS_PERF_COUNTERS_HPP_
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+#include "et/sys.hpp"
+
+// hardware counters around a benchmark loop, reported per iteration as user
+// counters (and so in --benchmark_format=json):
+//
+//   bench::PerfCounters perf(state);
+//   for (auto _ : state) { ... }
+//
+// Only read when ET_PERF_COUNTERS is set to something other than 0. Events
+// the kernel, perf_event_paranoid or the hypervisor refuse are left out of
+// the report; the first refusal is printed once to stderr.
+namespace bench {
+
+class PerfCounters {
+ public:
+  struct Event {
+    char const* name;
+    std::uint32_t type;
+    std::uint64_t config;
+  };
+
+  static constexpr auto kEvents = std::size_t(4);
+
+  static auto Events() noexcept -> std::array<Event, kEvents> const& {
+    static constexpr auto kL1iReadMiss =
+        std::uint64_t(PERF_COUNT_HW_CACHE_L1I) |
+        (std::uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8U) |
+        (std::uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16U);
+    static auto const events = std::array<Event, kEvents>{{
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"l1i_misses", PERF_TYPE_HW_CACHE, kL1iReadMiss},
+    }};
+    return events;
+  }
+
+  static auto Enabled() noexcept -> bool {
+    static auto const enabled = [] {
+      auto const* const env = std::getenv("ET_PERF_COUNTERS");
+      return env != nullptr && *env != '\0' && std::strcmp(env, "0") != 0;
+    }();
+    return enabled;
+  }
+
+  explicit PerfCounters(benchmark::State& state) : state_(state) {
+    fds_.fill(-1);
+    if (!Enabled()) {
+      return;
+    }
+    for (auto i = std::size_t(0); i < kEvents; ++i) {
+      fds_[i] = Open(Events()[i], leader_);
+      if (fds_[i] == -1) {
+        Warn(Events()[i], et::Errno::Last());
+      } else if (leader_ == -1) {
+        leader_ = fds_[i];
+      }
+    }
+    if (leader_ != -1) {
+      ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  PerfCounters(PerfCounters const&) = delete;
+  PerfCounters& operator=(PerfCounters const&) = delete;
+
+  ~PerfCounters() {
+    if (leader_ != -1) {
+      ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      Report();
+    }
+    for (auto const fd : fds_) {
+      if (fd != -1) {
+        ::close(fd);
+      }
+    }
+  }
+
+ private:
+  // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+  struct GroupRead {
+    std::uint64_t nr;
+    std::uint64_t time_enabled;
+    std::uint64_t time_running;
+    std::array<std::uint64_t, kEvents> values;
+  };
+
+  static auto Open(Event const& event, int const leader) noexcept -> int {
+    auto attr = perf_event_attr();
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = leader == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(
+        ::syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+  }
+
+  static void Warn(Event const& event, et::Errno const err) {
+    static std::once_flag once;
+    std::call_once(once, [&] {
+      std::cerr << "[bench::PerfCounters] " << event.name
+                << " unavailable, leaving it out: " << err << '\n';
+    });
+  }
+
+  void Report() {
+    auto group = GroupRead();
+    if (::read(leader_, &group, sizeof(group)) < 0 ||
+        group.time_running == 0) {
+      return;
+    }
+    // the kernel multiplexes groups that do not fit the PMU, scale back up
+    auto const scale = static_cast<double>(group.time_enabled) /
+                       static_cast<double>(group.time_running);
+    auto value = std::size_t(0);
+    for (auto i = std::size_t(0); i < kEvents && value < group.nr; ++i) {
+      if (fds_[i] != -1) {
+        state_.counters[Events()[i].name] = benchmark::Counter(
+            static_cast<double>(group.values[value++]) * scale,
+            benchmark::Counter::kAvgIterations);
+      }
+    }
+  }
+
+  benchmark::State& state_;
+  std::array<int, kEvents> fds_;
+  int leader_ = -1;
+};
+
+}  // namespace bench
+
+#endif  // ET_BENCHMARKS_PERF_COUNTERS_HPP_
@@ -0,0 +1,90 @@
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "perf_counters.hpp"
+#include "records.hpp"
+
+namespace {
+
+constexpr auto kFileSize = std::uint64_t(512) << 20U;
+
+class RecordsFile {
+ public:
+  RecordsFile() {
+    auto const fd = ::mkstemp(path_);
+    if (fd == -1) {
+      std::abort();
+    }
+    ::close(fd);
+    if (!records::Generate(path_, kFileSize)) {
+      std::abort();
+    }
+  }
+
+  ~RecordsFile() { ::unlink(path_); }
+
+  auto Path() const noexcept -> char const* { return path_; }
+
+ private:
+  char path_[32] = "/tmp/et_records_benchXXXXXX";
+};
+
+auto File() -> RecordsFile const& {
+  static auto const file = RecordsFile();
+  return file;
+}
+
+void BM_ParseLine(benchmark::State& state) {
+  auto const line = std::string("1234567\tcharlie\t-4213");
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const record =
+        records::ParseLine(line.data(), line.data() + line.size());
+    benchmark::DoNotOptimize(record);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(line.size() + 1));
+}
+BENCHMARK(BM_ParseLine);
+
+void BM_ParseLineError(benchmark::State& state) {
+  auto const line = std::string("1234567\tcharlie\tn/a");
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const record =
+        records::ParseLine(line.data(), line.data() + line.size());
+    benchmark::DoNotOptimize(record);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(line.size() + 1));
+}
+BENCHMARK(BM_ParseLineError);
+
+// reference end to end workload: chunked reads, per line Either, aggregation
+void BM_RecordsAggregate(benchmark::State& state) {
+  auto const& file = File();
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const summary = records::Aggregate(
+        file.Path(), static_cast<std::size_t>(state.range(0)));
+    if (!summary) {
+      state.SkipWithError("aggregation failed");
+      break;
+    }
+    benchmark::DoNotOptimize(summary.Success().amount);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kFileSize));
+}
+BENCHMARK(BM_RecordsAggregate)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
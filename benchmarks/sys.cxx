@@ -0,0 +1,91 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdlib>
+
+#include "benchmark/benchmark.h"
+#include "et/sys.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+// small page cached file so the syscall cost stays constant between variants
+class TempFile {
+ public:
+  TempFile() : fd_(::mkstemp(path_)) {
+    ::unlink(path_);
+    auto const block = std::array<char, 4096>{};
+    if (::write(fd_, block.data(), block.size()) == -1) {
+      std::abort();
+    }
+  }
+
+  ~TempFile() { ::close(fd_); }
+
+  auto Fd() const noexcept -> int { return fd_; }
+
+ private:
+  char path_[32] = "/tmp/et_sys_benchXXXXXX";
+  int fd_;
+};
+
+void BM_RawPread(benchmark::State& state) {
+  auto const file = TempFile();
+  auto buf = std::array<char, 64>{};
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const ret = ::pread(file.Fd(), buf.data(), buf.size(), 0);
+    if (ret == -1) {
+      state.SkipWithError("pread failed");
+      break;
+    }
+    benchmark::DoNotOptimize(ret);
+  }
+}
+BENCHMARK(BM_RawPread);
+
+void BM_EitherPread(benchmark::State& state) {
+  auto const file = TempFile();
+  auto buf = std::array<char, 64>{};
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const ret = et::sys::Pread(file.Fd(), buf.data(), buf.size(), 0);
+    if (!ret) {
+      state.SkipWithError("pread failed");
+      break;
+    }
+    benchmark::DoNotOptimize(ret.Success());
+  }
+}
+BENCHMARK(BM_EitherPread);
+
+void BM_RawLseek(benchmark::State& state) {
+  auto const file = TempFile();
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const ret = ::lseek(file.Fd(), 0, SEEK_CUR);
+    if (ret == -1) {
+      state.SkipWithError("lseek failed");
+      break;
+    }
+    benchmark::DoNotOptimize(ret);
+  }
+}
+BENCHMARK(BM_RawLseek);
+
+void BM_EitherLseek(benchmark::State& state) {
+  auto const file = TempFile();
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    auto const ret = et::sys::Lseek(file.Fd(), 0, SEEK_CUR);
+    if (!ret) {
+      state.SkipWithError("lseek failed");
+      break;
+    }
+    benchmark::DoNotOptimize(ret.Success());
+  }
+}
+BENCHMARK(BM_EitherLseek);
+
+}  // namespace
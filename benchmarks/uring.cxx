@@ -0,0 +1,102 @@
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "et/uring.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+constexpr auto kBlockSize = std::uint32_t(4096);
+constexpr auto kFileBlocks = std::size_t(4096);
+
+// page cached 16 MiB file, random block offsets shared by both variants
+class BlockFile {
+ public:
+  BlockFile() : fd_(::mkstemp(path_)) {
+    ::unlink(path_);
+    auto const block = std::vector<char>(kBlockSize, 'x');
+    for (auto i = std::size_t(0); i < kFileBlocks; ++i) {
+      if (!et::sys::Write(fd_, block.data(), block.size())) {
+        std::abort();
+      }
+    }
+  }
+
+  ~BlockFile() { ::close(fd_); }
+
+  auto Fd() const noexcept -> int { return fd_; }
+
+  static auto Offsets(std::size_t count) -> std::vector<std::uint64_t> {
+    auto rng = std::mt19937_64(42);
+    auto dist = std::uniform_int_distribution<std::uint64_t>(0, kFileBlocks - 1);
+    auto offsets = std::vector<std::uint64_t>(count);
+    for (auto& offset : offsets) {
+      offset = dist(rng) * kBlockSize;
+    }
+    return offsets;
+  }
+
+ private:
+  char path_[32] = "/tmp/et_uring_benchXXXXXX";
+  int fd_;
+};
+
+void BM_PreadLoop(benchmark::State& state) {
+  auto const batch = static_cast<std::size_t>(state.range(0));
+  auto const file = BlockFile();
+  auto const offsets = BlockFile::Offsets(batch);
+  auto buf = std::vector<char>(batch * kBlockSize);
+
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    for (auto i = std::size_t(0); i < batch; ++i) {
+      auto const read =
+          et::sys::Pread(file.Fd(), buf.data() + i * kBlockSize, kBlockSize,
+                         static_cast<::off_t>(offsets[i]));
+      benchmark::DoNotOptimize(read);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PreadLoop)->Arg(16)->Arg(64)->Arg(256);
+
+void BM_UringBatch(benchmark::State& state) {
+  auto const batch = static_cast<std::size_t>(state.range(0));
+  auto const file = BlockFile();
+  auto const offsets = BlockFile::Offsets(batch);
+  auto buf = std::vector<char>(batch * kBlockSize);
+
+  auto ring = et::uring::Ring::Create(static_cast<unsigned>(batch));
+  if (!ring) {
+    state.SkipWithError("io_uring unavailable");
+    return;
+  }
+  auto r = std::move(ring).Success();
+
+  auto ops = std::vector<et::uring::Op>();
+  for (auto i = std::size_t(0); i < batch; ++i) {
+    ops.push_back(et::uring::Op::Read(file.Fd(), buf.data() + i * kBlockSize,
+                                      kBlockSize, offsets[i], i));
+  }
+
+  bench::PerfCounters perf(state);
+  for (auto _ : state) {
+    if (!r.SubmitBatch(ops) || !r.Wait(batch)) {
+      state.SkipWithError("io_uring submission failed");
+      break;
+    }
+    r.Reap([](et::uring::Completion const& c) {
+      benchmark::DoNotOptimize(c.result);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UringBatch)->Arg(16)->Arg(64)->Arg(256);
+
+}  // namespace
@@ -0,0 +1,61 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "records.hpp"
+
+// usage: et_records [size in MiB = 1024] [threads = hardware concurrency]
+int main(int argc, char** argv) {
+  auto const size_mib =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024ULL;
+  auto const threads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+               : static_cast<unsigned long long>(
+                     std::max(1U, std::thread::hardware_concurrency()));
+
+  char path[] = "/tmp/et_recordsXXXXXX";
+  auto const fd = ::mkstemp(path);
+  if (fd == -1) {
+    std::cerr << "[records] error: unable to create temporary file"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  ::close(fd);
+
+  auto const lines = records::Generate(path, size_mib << 20U);
+  if (!lines) {
+    std::cerr << "[records::Generate] " << lines.Error() << std::endl;
+    ::unlink(path);
+    return EXIT_FAILURE;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+  auto const summary = records::Aggregate(path, threads);
+  auto const elapsed = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  ::unlink(path);
+
+  if (!summary) {
+    std::cerr << "[records::Aggregate] " << summary.Error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto const& s = summary.Success();
+  std::cout << "lines:      " << lines.Success() << '\n'
+            << "records:    " << s.records << '\n'
+            << "errors:     " << s.errors << '\n'
+            << "amount:     " << s.amount << '\n'
+            << "threads:    " << threads << '\n'
+            << "throughput: "
+            << static_cast<double>(size_mib) / 1024.0 / elapsed << " GiB/s"
+            << std::endl;
+
+  return s.records + s.errors == lines.Success() ? EXIT_SUCCESS
+                                                 : EXIT_FAILURE;
+}
@@ -0,0 +1,345 @@
+#ifndef ET_EXAMPLES_RECORDS_HPP_
+#define ET_EXAMPLES_RECORDS_HPP_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <et/either.hpp>
+#include <et/sys.hpp>
+
+// streaming TSV parser used as the end to end throughput workload:
+//   <id>\t<key>\t<amount>\n
+// every line yields an Either<Record, ParseError> that points into the chunk
+// buffer, so parsing never allocates per line
+namespace records {
+
+struct Field {
+  char const* data;
+  std::size_t size;
+};
+
+struct Record {
+  std::uint64_t id;
+  Field key;
+  std::int64_t amount;
+};
+
+struct ParseError {
+  enum class Kind : std::uint8_t {
+    kMissingField,
+    kBadNumber,
+    kTooManyFields,
+    kLineTooLong,
+  };
+
+  static constexpr auto kKinds = std::size_t(4);
+
+  Kind kind;
+  std::size_t column;
+};
+
+inline std::ostream& operator<<(std::ostream& os, ParseError const& err) {
+  static constexpr char const* kNames[] = {"missing field", "bad number",
+                                           "too many fields", "line too long"};
+  return os << "[records::ParseLine] error: "
+            << kNames[static_cast<std::size_t>(err.kind)] << " at column "
+            << err.column;
+}
+
+using ParseResult = et::Either<Record, ParseError>;
+
+namespace detail {
+
+inline auto NextField(char const*& it, char const* end) -> Field {
+  auto const sep = static_cast<char const*>(
+      std::memchr(it, '\t', static_cast<std::size_t>(end - it)));
+  auto const field_end = sep == nullptr ? end : sep;
+  auto const field = Field{it, static_cast<std::size_t>(field_end - it)};
+  it = sep == nullptr ? end : sep + 1;
+  return field;
+}
+
+inline auto ParseUnsigned(Field const field, std::uint64_t& out) -> bool {
+  if (field.size == 0 || field.size > 19) {
+    return false;
+  }
+  out = 0;
+  for (auto i = std::size_t(0); i < field.size; ++i) {
+    auto const digit = static_cast<unsigned char>(field.data[i] - '0');
+    if (digit > 9) {
+      return false;
+    }
+    out = out * 10 + digit;
+  }
+  return true;
+}
+
+inline auto ParseSigned(Field const field, std::int64_t& out) -> bool {
+  auto const negative = field.size > 0 && field.data[0] == '-';
+  auto const skip = negative ? std::size_t(1) : std::size_t(0);
+  auto magnitude = std::uint64_t(0);
+  if (!ParseUnsigned(Field{field.data + skip, field.size - skip}, magnitude) ||
+      magnitude > static_cast<std::uint64_t>(INT64_MAX)) {
+    return false;
+  }
+  out = negative ? -static_cast<std::int64_t>(magnitude)
+                 : static_cast<std::int64_t>(magnitude);
+  return true;
+}
+
+}  // namespace detail
+
+// parses one line without its terminating newline
+inline auto ParseLine(char const* begin, char const* end) -> ParseResult {
+  auto it = begin;
+  Field fields[3];
+  for (auto i = std::size_t(0); i < 3; ++i) {
+    if (it == end && i > 0) {
+      return et::Error(ParseError{ParseError::Kind::kMissingField, i});
+    }
+    fields[i] = detail::NextField(it, end);
+  }
+  if (it != end) {
+    return et::Error(ParseError{ParseError::Kind::kTooManyFields, 3});
+  }
+
+  auto record = Record{0, fields[1], 0};
+  if (!detail::ParseUnsigned(fields[0], record.id)) {
+    return et::Error(ParseError{ParseError::Kind::kBadNumber, 0});
+  }
+  if (!detail::ParseSigned(fields[2], record.amount)) {
+    return et::Error(ParseError{ParseError::Kind::kBadNumber, 2});
+  }
+
+  return et::Success(record);
+}
+
+// reads lines starting in [begin, end) of a file chunk by chunk through
+// pread; a line straddling two chunks is moved to the front of the buffer
+class ChunkReader {
+ public:
+  static constexpr auto kChunkSize = std::size_t(1) << 20U;
+
+  ChunkReader(int fd, std::uint64_t begin, std::uint64_t end)
+      : fd_(fd), offset_(begin), end_(end), buf_(kChunkSize) {
+    // a range not starting at 0 belongs to the line that crosses it only if
+    // that line starts exactly at begin, so resume after the previous newline
+    if (begin > 0) {
+      offset_ = begin - 1;
+      skip_first_ = true;
+    }
+  }
+
+  // invokes on_line(ParseResult const&) for every line; yields the errno of a
+  // failed read
+  template <class F>
+  auto ForEach(F&& on_line) -> et::Either<std::uint64_t, et::Errno> {
+    auto lines = std::uint64_t(0);
+    auto line_offset = offset_;
+    auto filled = std::size_t(0);
+    auto eof = false;
+
+    while (!eof) {
+      auto const read =
+          et::sys::Pread(fd_, buf_.data() + filled, buf_.size() - filled,
+                         static_cast<::off_t>(offset_));
+      if (!read) {
+        return et::Error(read.Error());
+      }
+      auto const got = static_cast<std::size_t>(read.Success());
+      offset_ += got;
+      filled += got;
+      eof = got == 0;
+
+      auto it = static_cast<char const*>(buf_.data());
+      auto const last = it + filled;
+      while (it != last) {
+        auto const nl = static_cast<char const*>(
+            std::memchr(it, '\n', static_cast<std::size_t>(last - it)));
+        if (nl == nullptr && !eof) {
+          break;
+        }
+        auto const line_end = nl == nullptr ? last : nl;
+
+        if (skip_first_) {
+          skip_first_ = false;
+        } else if (line_offset < end_) {
+          on_line(ParseLine(it, line_end));
+          ++lines;
+        } else {
+          return et::Success(lines);
+        }
+
+        line_offset += static_cast<std::uint64_t>(line_end - it) + 1;
+        it = nl == nullptr ? last : nl + 1;
+      }
+
+      filled = static_cast<std::size_t>(last - it);
+      if (filled == buf_.size()) {
+        // no newline in a whole chunk, report the line once and skip the rest
+        if (!skip_first_) {
+          if (line_offset >= end_) {
+            return et::Success(lines);
+          }
+          on_line(ParseResult(
+              et::Error(ParseError{ParseError::Kind::kLineTooLong, 0})));
+          ++lines;
+          skip_first_ = true;
+        }
+        line_offset += filled;
+        filled = 0;
+      }
+      std::memmove(buf_.data(), it, filled);
+    }
+
+    return et::Success(lines);
+  }
+
+ private:
+  int fd_;
+  std::uint64_t offset_;
+  std::uint64_t end_;
+  bool skip_first_ = false;
+  std::vector<char> buf_;
+};
+
+struct Summary {
+  std::uint64_t records = 0;
+  std::uint64_t errors = 0;
+  std::int64_t amount = 0;
+  std::uint64_t key_bytes = 0;
+  std::array<std::uint64_t, ParseError::kKinds> error_kinds{};
+
+  void Add(ParseResult const& result) {
+    if (result) {
+      auto const& record = result.Success();
+      ++records;
+      amount += record.amount;
+      key_bytes += record.key.size;
+    } else {
+      ++errors;
+      ++error_kinds[static_cast<std::size_t>(result.Error().kind)];
+    }
+  }
+
+  void Merge(Summary const& that) {
+    records += that.records;
+    errors += that.errors;
+    amount += that.amount;
+    key_bytes += that.key_bytes;
+    for (auto i = std::size_t(0); i < error_kinds.size(); ++i) {
+      error_kinds[i] += that.error_kinds[i];
+    }
+  }
+};
+
+// single pass aggregation split into line aligned ranges, one per thread
+inline auto Aggregate(char const* path, std::size_t threads)
+    -> et::Either<Summary, et::Errno> {
+  auto const fd = et::sys::Open(path, O_RDONLY | O_CLOEXEC);
+  if (!fd) {
+    return et::Error(fd.Error());
+  }
+  auto const st = et::sys::Fstat(fd.Success());
+  if (!st) {
+    ::close(fd.Success());
+    return et::Error(st.Error());
+  }
+
+  threads = std::max(threads, std::size_t(1));
+  auto const size = static_cast<std::uint64_t>(st.Success().st_size);
+  auto const step = size / threads + 1;
+
+  auto summaries = std::vector<Summary>(threads);
+  auto failures = std::vector<int>(threads, 0);
+  auto workers = std::vector<std::thread>();
+  for (auto i = std::size_t(0); i < threads; ++i) {
+    workers.emplace_back([&, i] {
+      auto const begin = std::min(size, i * step);
+      auto const end = std::min(size, begin + step);
+      auto reader = ChunkReader(fd.Success(), begin, end);
+      auto const lines = reader.ForEach(
+          [&summary = summaries[i]](ParseResult const& r) { summary.Add(r); });
+      if (!lines) {
+        failures[i] = lines.Error().Value();
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  ::close(fd.Success());
+
+  auto total = Summary();
+  for (auto i = std::size_t(0); i < threads; ++i) {
+    if (failures[i] != 0) {
+      return et::Error(et::Errno(failures[i]));
+    }
+    total.Merge(summaries[i]);
+  }
+  return et::Success(total);
+}
+
+// writes roughly size bytes of records, one in error_every lines malformed
+inline auto Generate(char const* path, std::uint64_t size,
+                     std::uint64_t error_every = 1000)
+    -> et::Either<std::uint64_t, et::Errno> {
+  auto const fd =
+      et::sys::Open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (!fd) {
+    return et::Error(fd.Error());
+  }
+
+  static constexpr char const* kKeys[] = {"alpha", "bravo", "charlie", "delta",
+                                          "echo",  "foxtrot"};
+  auto rng = std::mt19937_64(42);
+  auto buf = std::string();
+  auto lines = std::uint64_t(0);
+
+  for (auto written = std::uint64_t(0); written < size;) {
+    buf.clear();
+    while (buf.size() < ChunkReader::kChunkSize) {
+      auto const roll = rng();
+      buf += std::to_string(lines);
+      buf += '\t';
+      buf += kKeys[roll % 6];
+      buf += '\t';
+      if (lines % error_every == error_every - 1) {
+        buf += "n/a";
+      } else {
+        buf += std::to_string(static_cast<std::int64_t>(roll % 20001) - 10000);
+      }
+      buf += '\n';
+      ++lines;
+    }
+
+    for (auto pending = std::size_t(0); pending < buf.size();) {
+      auto const wrote = et::sys::Write(fd.Success(), buf.data() + pending,
+                                        buf.size() - pending);
+      if (!wrote) {
+        ::close(fd.Success());
+        return et::Error(wrote.Error());
+      }
+      pending += static_cast<std::size_t>(wrote.Success());
+    }
+    written += buf.size();
+  }
+
+  ::close(fd.Success());
+  return et::Success(lines);
+}
+
+}  // namespace records
+
+#endif  // ET_EXAMPLES_RECORDS_HPP_
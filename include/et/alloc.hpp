@@ -0,0 +1,327 @@
+#ifndef ET_ALLOC_HPP_
+#define ET_ALLOC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "et/either.hpp"
+
+namespace et {
+
+class AllocError {
+ public:
+  enum class Kind {
+    kOutOfMemory,  // the heap refused the request
+    kTooLarge,     // the request in bytes does not fit std::size_t
+    kExhausted,    // a bump or pool allocator has no room left
+  };
+
+  constexpr AllocError(Kind kind, std::size_t bytes) noexcept
+      : kind_(kind), bytes_(bytes) {}
+
+  constexpr auto GetKind() const noexcept -> Kind { return kind_; }
+
+  // bytes requested, the maximum for kTooLarge
+  constexpr auto Bytes() const noexcept -> std::size_t { return bytes_; }
+
+ private:
+  Kind kind_;
+  std::size_t bytes_;
+};
+
+constexpr bool operator==(AllocError const lhs, AllocError const rhs) noexcept {
+  return lhs.GetKind() == rhs.GetKind() && lhs.Bytes() == rhs.Bytes();
+}
+
+constexpr bool operator!=(AllocError const lhs, AllocError const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, AllocError const err) {
+  using Kind = AllocError::Kind;
+  switch (err.GetKind()) {
+    case Kind::kOutOfMemory:
+      return os << "out of memory allocating " << err.Bytes() << " bytes";
+    case Kind::kTooLarge:
+      return os << "allocation larger than " << err.Bytes() << " bytes";
+    case Kind::kExhausted:
+      return os << "allocator exhausted allocating " << err.Bytes()
+                << " bytes";
+  }
+  return os;
+}
+
+namespace detail {
+
+template <class T>
+constexpr auto MaxElements() noexcept -> std::size_t {
+  return std::numeric_limits<std::size_t>::max() / sizeof(T);
+}
+
+// the nothrow operator new matching T's alignment; C++14 has none for over
+// aligned types
+template <class T>
+auto NewBytes(std::size_t const bytes) noexcept -> void* {
+#if defined(__cpp_aligned_new)
+  if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return ::operator new(bytes, std::align_val_t(alignof(T)), std::nothrow);
+  }
+#else
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "[et::TryAllocate] over aligned types need C++17");
+#endif
+  return ::operator new(bytes, std::nothrow);
+}
+
+template <class T>
+void DeleteBytes(void* const ptr) noexcept {
+#if defined(__cpp_aligned_new)
+  if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+    return;
+  }
+#endif
+  ::operator delete(ptr);
+}
+
+}  // namespace detail
+
+// uninitialized storage for n objects of type T from the heap, released with
+// et::Deallocate. Failure is a value: no std::bad_alloc leaves this.
+template <class T>
+auto TryAllocate(std::size_t const n) noexcept -> Either<T*, AllocError> {
+  if (ET_UNLIKELY(n > detail::MaxElements<T>())) {
+    return Error(AllocError(AllocError::Kind::kTooLarge,
+                            detail::MaxElements<T>() * sizeof(T)));
+  }
+  auto* const ptr = detail::NewBytes<T>(n * sizeof(T));
+  if (ET_LIKELY(ptr != nullptr)) {
+    return Success(static_cast<T*>(ptr));
+  }
+  return Error(AllocError(AllocError::Kind::kOutOfMemory, n * sizeof(T)));
+}
+
+template <class T>
+void Deallocate(T* const ptr) noexcept {
+  detail::DeleteBytes<T>(ptr);
+}
+
+// std::make_unique reporting a failed allocation as a value; exceptions of
+// T's constructor still propagate, after the memory is released
+template <class T, class... Args>
+auto TryMakeUnique(Args&&... args)
+    -> Either<std::unique_ptr<T>, AllocError> {
+  auto* const ptr = new (std::nothrow) T(std::forward<Args>(args)...);
+  if (ET_LIKELY(ptr != nullptr)) {
+    return Success(std::unique_ptr<T>(ptr));
+  }
+  return Error(AllocError(AllocError::Kind::kOutOfMemory, sizeof(T)));
+}
+
+// Hands out consecutive, aligned pieces of one buffer, released all at once
+// by Reset(). The buffer is either the caller's or allocated once by
+// Create().
+class BumpAllocator {
+ public:
+  BumpAllocator(void* const buffer, std::size_t const capacity) noexcept
+      : base_(static_cast<unsigned char*>(buffer)),
+        capacity_(capacity),
+        offset_(0),
+        owned_(false) {}
+
+  static auto Create(std::size_t const capacity)
+      -> Either<BumpAllocator, AllocError> {
+    // rounding up to whole std::max_align_t must not wrap around
+    if (ET_UNLIKELY(capacity > std::numeric_limits<std::size_t>::max() -
+                                   (sizeof(std::max_align_t) - 1))) {
+      return Error(AllocError(AllocError::Kind::kTooLarge,
+                              std::numeric_limits<std::size_t>::max() -
+                                  (sizeof(std::max_align_t) - 1)));
+    }
+    auto buffer = TryAllocate<std::max_align_t>(
+        (capacity + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+    if (!buffer) {
+      return Error(buffer.Error());
+    }
+    auto allocator = BumpAllocator(buffer.Success(), capacity);
+    allocator.owned_ = true;
+    return Success(std::move(allocator));
+  }
+
+  BumpAllocator(BumpAllocator const&) = delete;
+  BumpAllocator& operator=(BumpAllocator const&) = delete;
+
+  BumpAllocator(BumpAllocator&& that) noexcept
+      : base_(that.base_),
+        capacity_(that.capacity_),
+        offset_(that.offset_),
+        owned_(that.owned_) {
+    that.Forget();
+  }
+
+  BumpAllocator& operator=(BumpAllocator&& that) noexcept {
+    if (this != &that) {
+      Release();
+      base_ = that.base_;
+      capacity_ = that.capacity_;
+      offset_ = that.offset_;
+      owned_ = that.owned_;
+      that.Forget();
+    }
+    return *this;
+  }
+
+  ~BumpAllocator() { Release(); }
+
+  // uninitialized storage for n objects of type T
+  template <class T>
+  auto Allocate(std::size_t const n = 1) noexcept -> Either<T*, AllocError> {
+    if (ET_UNLIKELY(n > detail::MaxElements<T>())) {
+      return Error(AllocError(AllocError::Kind::kTooLarge,
+                              detail::MaxElements<T>() * sizeof(T)));
+    }
+    auto const bytes = AllocateBytes(n * sizeof(T), alignof(T));
+    if (ET_LIKELY(bytes.IsSuccess())) {
+      return Success(static_cast<T*>(bytes.Success()));
+    }
+    return Error(bytes.Error());
+  }
+
+  // alignment is a power of two
+  auto AllocateBytes(std::size_t const bytes,
+                     std::size_t const alignment) noexcept
+      -> Either<void*, AllocError> {
+    auto const address = reinterpret_cast<std::uintptr_t>(base_);
+    auto const start =
+        ((address + offset_ + alignment - 1) & ~(alignment - 1)) - address;
+    if (ET_LIKELY(start <= capacity_ && bytes <= capacity_ - start)) {
+      offset_ = start + bytes;
+      return Success(static_cast<void*>(base_ + start));
+    }
+    return Error(AllocError(AllocError::Kind::kExhausted, bytes));
+  }
+
+  // every piece handed out so far becomes invalid
+  void Reset() noexcept { offset_ = 0; }
+
+  auto Capacity() const noexcept -> std::size_t { return capacity_; }
+  auto Used() const noexcept -> std::size_t { return offset_; }
+
+ private:
+  void Release() noexcept {
+    if (owned_) {
+      Deallocate(reinterpret_cast<std::max_align_t*>(base_));
+      owned_ = false;
+    }
+  }
+
+  // a moved from allocator has no buffer left to hand out
+  void Forget() noexcept {
+    base_ = nullptr;
+    capacity_ = 0;
+    offset_ = 0;
+    owned_ = false;
+  }
+
+  unsigned char* base_;
+  std::size_t capacity_;
+  std::size_t offset_;
+  bool owned_;
+};
+
+// Fixed number of slots for single objects of type T, allocated once by
+// Create() and recycled through an intrusive free list: Allocate() and
+// Deallocate() are a pointer pop and push.
+template <class T>
+class PoolAllocator {
+ public:
+  static auto Create(std::size_t const slots)
+      -> Either<PoolAllocator, AllocError> {
+    auto storage = TryAllocate<Slot>(slots);
+    if (!storage) {
+      return Error(storage.Error());
+    }
+    return Success(PoolAllocator(storage.Success(), slots));
+  }
+
+  PoolAllocator(PoolAllocator const&) = delete;
+  PoolAllocator& operator=(PoolAllocator const&) = delete;
+
+  PoolAllocator(PoolAllocator&& that) noexcept
+      : slots_(that.slots_),
+        free_(that.free_),
+        count_(that.count_),
+        available_(that.available_) {
+    that.slots_ = nullptr;
+    that.free_ = nullptr;
+    that.count_ = 0;
+    that.available_ = 0;
+  }
+
+  PoolAllocator& operator=(PoolAllocator&& that) noexcept {
+    if (this != &that) {
+      et::Deallocate(slots_);
+      slots_ = that.slots_;
+      free_ = that.free_;
+      count_ = that.count_;
+      available_ = that.available_;
+      that.slots_ = nullptr;
+      that.free_ = nullptr;
+      that.count_ = 0;
+      that.available_ = 0;
+    }
+    return *this;
+  }
+
+  ~PoolAllocator() { et::Deallocate(slots_); }
+
+  // uninitialized storage for one T
+  auto Allocate() noexcept -> Either<T*, AllocError> {
+    if (ET_LIKELY(free_ != nullptr)) {
+      auto* const slot = free_;
+      free_ = slot->next;
+      --available_;
+      return Success(reinterpret_cast<T*>(slot->storage));
+    }
+    return Error(AllocError(AllocError::Kind::kExhausted, sizeof(T)));
+  }
+
+  // ptr came from Allocate() and its object is destroyed
+  void Deallocate(T* const ptr) noexcept {
+    auto* const slot = reinterpret_cast<Slot*>(ptr);
+    slot->next = free_;
+    free_ = slot;
+    ++available_;
+  }
+
+  auto Slots() const noexcept -> std::size_t { return count_; }
+  auto Available() const noexcept -> std::size_t { return available_; }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  PoolAllocator(Slot* const slots, std::size_t const count) noexcept
+      : slots_(slots), free_(nullptr), count_(count), available_(count) {
+    for (auto i = count; i > 0; --i) {
+      slots_[i - 1].next = free_;
+      free_ = &slots_[i - 1];
+    }
+  }
+
+  Slot* slots_;
+  Slot* free_;
+  std::size_t count_;
+  std::size_t available_;
+};
+
+}  // namespace et
+
+#endif  // ET_ALLOC_HPP_
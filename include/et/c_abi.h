@@ -0,0 +1,127 @@
+#ifndef ET_C_ABI_H_
+#define ET_C_ABI_H_
+
+/* C view of et::Either<S, E> for trivially copyable payloads, usable from C
+ * and as the #[repr(C)] model on the Rust side:
+ *
+ *   #[repr(C)] union EtI64Value { success: i64, error: i32 }
+ *   #[repr(C)] struct EtResultI64 { state: i32, value: EtI64Value }
+ *
+ * The struct has the layout of the C++ Either, so a result crosses the
+ * boundary by value (in registers where the ABI passes a struct of its size
+ * that way) or by memcpy. state is one of the ET_C_* constants; value.success
+ * is valid only for ET_C_SUCCESS and value.error only for ET_C_ERROR. */
+
+#include <stdint.h>
+
+enum { ET_C_EMPTY = 0, ET_C_ERROR = 1, ET_C_SUCCESS = 2 };
+
+#define ET_C_EITHER(name, success_type, error_type) \
+  typedef struct name {                             \
+    int32_t state;                                  \
+    union {                                         \
+      success_type success;                         \
+      error_type error;                             \
+    } value;                                        \
+  } name
+
+/* common shapes: a value, or an errno style error code */
+ET_C_EITHER(et_result_i32, int32_t, int32_t);
+ET_C_EITHER(et_result_i64, int64_t, int32_t);
+ET_C_EITHER(et_result_u64, uint64_t, int32_t);
+ET_C_EITHER(et_result_f64, double, int32_t);
+ET_C_EITHER(et_result_ptr, void*, int32_t);
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// the C type standing for T in a C struct: enums are their underlying
+// type, everything else itself. Specialize for wrappers such as
+// struct Code { std::int32_t value; } to let them cross as their field.
+template <class T, bool = std::is_enum<T>::value>
+struct CRepr {
+  using type = T;
+};
+
+template <class T>
+struct CRepr<T, true> {
+  using type = std::underlying_type_t<T>;
+};
+
+namespace detail {
+
+template <class C>
+using CSuccessType = decltype(std::declval<C&>().value.success);
+
+template <class C>
+using CErrorType = decltype(std::declval<C&>().value.error);
+
+// where Storage places its payload union: right after the state, aligned
+template <class S, class E>
+constexpr auto PayloadOffset() noexcept -> std::size_t {
+  return (sizeof(StorageState) + alignof(Either<S, E>) - 1) /
+         alignof(Either<S, E>) * alignof(Either<S, E>);
+}
+
+// C struct C and Either<S, E> agree field by field and byte by byte
+template <class C, class S, class E>
+struct CLayoutMatches
+    : meta::BoolConstant<
+          meta::All<std::is_trivially_copyable, S, E>::value &&
+          std::is_standard_layout<Either<S, E>>::value &&
+          std::is_same<typename CRepr<S>::type, CSuccessType<C>>::value &&
+          std::is_same<typename CRepr<E>::type, CErrorType<C>>::value &&
+          sizeof(S) == sizeof(CSuccessType<C>) &&
+          sizeof(E) == sizeof(CErrorType<C>) &&
+          sizeof(StorageState) == sizeof(std::declval<C&>().state) &&
+          sizeof(Either<S, E>) == sizeof(C) &&
+          alignof(Either<S, E>) == alignof(C) &&
+          offsetof(C, state) == 0 &&
+          offsetof(C, value) == PayloadOffset<S, E>()> {};
+
+static_assert(static_cast<int>(StorageState::kEmpty) == ET_C_EMPTY,
+              "[et::c_abi] state values out of sync");
+static_assert(static_cast<int>(StorageState::kHasError) == ET_C_ERROR,
+              "[et::c_abi] state values out of sync");
+static_assert(static_cast<int>(StorageState::kHasSuccess) == ET_C_SUCCESS,
+              "[et::c_abi] state values out of sync");
+
+}  // namespace detail
+
+// copies the bytes of an Either into its C struct, which compiles to a plain
+// register or memory move
+template <class C, class S, class E>
+auto ToC(Either<S, E> const& either) noexcept -> C {
+  static_assert(detail::CLayoutMatches<C, S, E>::value,
+                "[et::ToC] C struct does not match the Either layout");
+  C c;
+  std::memcpy(&c, &either, sizeof(C));
+  return c;
+}
+
+// the inverse of ToC. A state other than ET_C_SUCCESS or ET_C_ERROR, such as
+// an uninitialized one from a foreign caller, reads as an empty Either.
+template <class S, class E, class C>
+auto FromC(C const& c) noexcept -> Either<S, E> {
+  static_assert(detail::CLayoutMatches<C, S, E>::value,
+                "[et::FromC] C struct does not match the Either layout");
+  auto either = Either<S, E>();
+  if (c.state == ET_C_SUCCESS || c.state == ET_C_ERROR) {
+    // trivially copyable, only its default constructor is user provided
+    std::memcpy(static_cast<void*>(&either), &c, sizeof(C));
+  }
+  return either;
+}
+
+}  // namespace et
+
+#endif  // __cplusplus
+
+#endif  // ET_C_ABI_H_
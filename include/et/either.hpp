@@ -1,12 +1,24 @@
 #ifndef ET_EITHER_HPP_
 #define ET_EITHER_HPP_
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#if defined(__GNUC__) || defined(__clang__)
+#define ET_LIKELY(x) __builtin_expect(!!(x), 1)
+#define ET_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define ET_LIKELY(x) (x)
+#define ET_UNLIKELY(x) (x)
+#endif
+
 namespace et {
 
 template <class S, class E>
@@ -23,8 +35,20 @@ using ErrorTagType = ErrorTagImpl const&;
 constexpr detail::SuccessTagImpl SuccessTag;
 constexpr detail::ErrorTagImpl ErrorTag;
 
+// the union member active in an empty storage, never read
+struct NoPayload {};
+
 }  // namespace detail
 
+// selects the empty state of Either<S, E>, which holds neither payload. A
+// moved from Either is empty too unless both payloads are trivially copyable:
+// those move as plain copies and the source keeps its value.
+struct EmptyType {
+  explicit constexpr EmptyType(int) noexcept {}
+};
+
+constexpr EmptyType empty(0);
+
 class BadEitherAccess : public std::logic_error {
  public:
   explicit BadEitherAccess(char const* msg) : std::logic_error(msg) {}
@@ -62,6 +86,14 @@ using NotVoid = BoolConstant<!std::is_void<T>::value>;
 template <class...>
 using VoidType = void;
 
+// stands in for a parameter type that can never be passed
+struct Nonesuch {
+  Nonesuch() = delete;
+  ~Nonesuch() = delete;
+  Nonesuch(Nonesuch const&) = delete;
+  void operator=(Nonesuch const&) = delete;
+};
+
 template <class T, class = VoidType<>>
 struct IsPrintable : std::false_type {};
 
@@ -74,51 +106,28 @@ struct IsStdHashable : std::false_type {};
 
 template <class T>
 struct IsStdHashable<
-    T, VoidType<decltype(std::declval<std::hash<T>()(std::declval<T>())>)>>
+    T, VoidType<decltype(std::hash<T>()(std::declval<T const&>()))>>
     : std::true_type {};
 
+template <class T>
+using IsStdHashableOrVoid =
+    BoolConstant<std::is_void<T>::value || IsStdHashable<T>::value>;
+
 }  // namespace meta
 
 enum class StorageState { kEmpty, kHasError, kHasSuccess };
 
-// default case for trivially destructible
+// default case for trivially copyable payloads: the implicit special members
+// are trivial and therefore usable in constant expressions. A move is a copy,
+// so the source keeps its payload instead of becoming empty.
 template <class S, class E,
-          bool = meta::All<std::is_trivially_destructible, S, E>::value>
+          bool = meta::All<std::is_trivially_copyable, S, E>::value>
 class Storage {
  public:
   using SuccessType = S;
   using ErrorType = E;
 
  protected:
-  template <class SS = SuccessType, class EE = ErrorType,
-            class = std::enable_if_t<
-                meta::All<std::is_copy_assignable, SS, EE>::value>>
-  constexpr Storage operator=(Storage const& that) noexcept(
-      meta::All<std::is_nothrow_copy_assignable, SS, EE>::value) {
-    state_ = that.state_;
-    if (state_ == StorageState::kHasSuccess) {
-      succ_val_ = that.succ_val_;
-    } else if (state_ == StorageState::kHasError) {
-      err_val_ = that.err_val_;
-    }
-  }
-
-  template <class SS = SuccessType, class EE = ErrorType,
-            class = std::enable_if_t<
-                meta::All<std::is_move_assignable, SS, EE>::value>>
-  constexpr Storage(Storage&& that) noexcept(
-      meta::All<std::is_nothrow_move_assignable, SS, EE>::value)
-      : state_(that.state_) {
-    state_ = that.state_;
-    if (state_ == StorageState::kHasSuccess) {
-      succ_val_ = std::move(that.succ_val_);
-      that.state_ = StorageState::kEmpty;
-    } else if (state_ == StorageState::kHasError) {
-      err_val_ = std::move(that.err_val_);
-      that.state_ = StorageState::kEmpty;
-    }
-  }
-
   constexpr Storage(SuccessTagType, SuccessType const& succ_val) noexcept(
       std::is_nothrow_copy_constructible<SuccessType>::value)
       : state_(StorageState::kHasSuccess), succ_val_(succ_val) {}
@@ -135,8 +144,13 @@ class Storage {
       std::is_nothrow_move_constructible<ErrorType>::value)
       : state_(StorageState::kHasError), err_val_(std::move(err_val)) {}
 
+  // leaves the payload bytes untouched
+  constexpr explicit Storage(EmptyType) noexcept
+      : state_(StorageState::kEmpty), none_() {}
+
   StorageState state_;
   union {
+    NoPayload none_;
     SuccessType succ_val_;
     ErrorType err_val_;
   };
@@ -149,32 +163,73 @@ class Storage<S, E, false> {
   using ErrorType = E;
 
  protected:
-  template <class SS = SuccessType, class EE = ErrorType,
-            class = std::enable_if_t<
-                meta::All<std::is_copy_assignable, SS, EE>::value>>
-  constexpr Storage operator=(Storage const& that) noexcept(
-      meta::All<std::is_nothrow_copy_assignable, SS, EE>::value) {
-    state_ = that.state_;
-    if (state_ == StorageState::kHasSuccess) {
-      succ_val_ = that.succ_val_;
-    } else if (state_ == StorageState::kHasError) {
-      err_val_ = that.err_val_;
+  // the special members take meta::Nonesuch instead of Storage when the
+  // payloads do not support them, so the implicitly deleted ones stay
+  using CopyArg = std::conditional_t<
+      meta::All<std::is_copy_constructible, S, E>::value, Storage,
+      meta::Nonesuch>;
+  using MoveArg = std::conditional_t<
+      meta::All<std::is_move_constructible, S, E>::value, Storage,
+      meta::Nonesuch>;
+  using CopyAssignArg = std::conditional_t<
+      meta::All<std::is_copy_constructible, S, E>::value &&
+          meta::All<std::is_copy_assignable, S, E>::value,
+      Storage, meta::Nonesuch>;
+  using MoveAssignArg = std::conditional_t<
+      meta::All<std::is_move_constructible, S, E>::value &&
+          meta::All<std::is_move_assignable, S, E>::value,
+      Storage, meta::Nonesuch>;
+
+  Storage(CopyArg const& that) noexcept(
+      meta::All<std::is_nothrow_copy_constructible, S, E>::value)
+      : state_(StorageState::kEmpty) {
+    CopyFrom(that);
+  }
+
+  // the moved from payload is destroyed, leaving the source empty
+  Storage(MoveArg&& that) noexcept(
+      meta::All<std::is_nothrow_move_constructible, S, E>::value)
+      : state_(StorageState::kEmpty) {
+    MoveFrom(that);
+  }
+
+  Storage& operator=(CopyAssignArg const& that) noexcept(
+      meta::All<std::is_nothrow_copy_constructible, S, E>::value &&
+      meta::All<std::is_nothrow_copy_assignable, S, E>::value) {
+    if (this == &that) {
+      return *this;
+    }
+    if (state_ == that.state_) {
+      if (state_ == StorageState::kHasSuccess) {
+        succ_val_ = that.succ_val_;
+      } else if (state_ == StorageState::kHasError) {
+        err_val_ = that.err_val_;
+      }
+    } else {
+      Reset();
+      CopyFrom(that);
     }
+    return *this;
   }
 
-  template <class SS = SuccessType, class EE = ErrorType,
-            class = std::enable_if_t<
-                meta::All<std::is_move_assignable, SS, EE>::value>>
-  constexpr Storage(Storage&& that) noexcept(
-      meta::All<std::is_nothrow_move_assignable, SS, EE>::value) {
-    state_ = that.state_;
-    if (state_ == StorageState::kHasSuccess) {
-      succ_val_ = std::move(that.succ_val_);
-      that.state_ = StorageState::kEmpty;
-    } else if (state_ == StorageState::kHasError) {
-      err_val_ = std::move(that.err_val_);
-      that.state_ = StorageState::kEmpty;
+  Storage& operator=(MoveAssignArg&& that) noexcept(
+      meta::All<std::is_nothrow_move_constructible, S, E>::value &&
+      meta::All<std::is_nothrow_move_assignable, S, E>::value) {
+    if (this == &that) {
+      return *this;
+    }
+    if (state_ == that.state_) {
+      if (state_ == StorageState::kHasSuccess) {
+        succ_val_ = std::move(that.succ_val_);
+      } else if (state_ == StorageState::kHasError) {
+        err_val_ = std::move(that.err_val_);
+      }
+      that.Reset();
+    } else {
+      Reset();
+      MoveFrom(that);
     }
+    return *this;
   }
 
   constexpr Storage(SuccessTagType, SuccessType const& succ_val) noexcept(
@@ -193,20 +248,338 @@ class Storage<S, E, false> {
       std::is_nothrow_move_constructible<ErrorType>::value)
       : state_(StorageState::kHasError), err_val_(std::move(err_val)) {}
 
+  // leaves the payload bytes untouched
+  constexpr explicit Storage(EmptyType) noexcept
+      : state_(StorageState::kEmpty), none_() {}
+
   ~Storage() noexcept(
       meta::All<std::is_nothrow_destructible, SuccessType, ErrorType>::value) {
+    Reset();
+  }
+
+  void Reset() noexcept(
+      meta::All<std::is_nothrow_destructible, SuccessType, ErrorType>::value) {
+    if (state_ == StorageState::kHasSuccess) {
+      succ_val_.~SuccessType();
+    } else if (state_ == StorageState::kHasError) {
+      err_val_.~ErrorType();
+    }
+    state_ = StorageState::kEmpty;
+  }
+
+  // expects an empty storage
+  void CopyFrom(Storage const& that) {
+    if (that.state_ == StorageState::kHasSuccess) {
+      ::new (static_cast<void*>(&succ_val_)) SuccessType(that.succ_val_);
+    } else if (that.state_ == StorageState::kHasError) {
+      ::new (static_cast<void*>(&err_val_)) ErrorType(that.err_val_);
+    }
+    state_ = that.state_;
+  }
+
+  // expects an empty storage, leaves that empty
+  void MoveFrom(Storage& that) {
+    if (that.state_ == StorageState::kHasSuccess) {
+      ::new (static_cast<void*>(&succ_val_))
+          SuccessType(std::move(that.succ_val_));
+    } else if (that.state_ == StorageState::kHasError) {
+      ::new (static_cast<void*>(&err_val_)) ErrorType(std::move(that.err_val_));
+    }
+    state_ = that.state_;
+    that.Reset();
+  }
+
+  StorageState state_;
+  union {
+    NoPayload none_;
+    SuccessType succ_val_;
+    ErrorType err_val_;
+  };
+};
+
+template <class T, class = meta::VoidType<>>
+struct AllocatorTypeOf {
+  using type = void;
+};
+
+template <class T>
+struct AllocatorTypeOf<T, meta::VoidType<typename T::allocator_type>> {
+  using type = std::conditional_t<
+      std::allocator_traits<typename T::allocator_type>::is_always_equal::value,
+      void, typename T::allocator_type>;
+};
+
+// allocator Either<S, E> keeps for its payloads: the stateful allocator_type
+// of S or else of E, void when neither has one (std::allocator included)
+template <class S, class E,
+          class SA = typename AllocatorTypeOf<S>::type>
+struct EitherAllocator {
+  using type = SA;
+};
+
+template <class S, class E>
+struct EitherAllocator<S, E, void> {
+  using type = typename AllocatorTypeOf<E>::type;
+};
+
+template <class S, class E>
+using EitherAllocatorType = typename EitherAllocator<S, E>::type;
+
+// public allocator_type of Either, which std::uses_allocator looks for
+template <class A>
+struct EitherAllocatorTypedef {
+  using allocator_type = A;
+};
+
+template <>
+struct EitherAllocatorTypedef<void> {};
+
+// uses allocator construction: T(std::allocator_arg, alloc, args...),
+// T(args..., alloc) or T(args...) when T does not use A
+template <class T, class A, class... Args>
+void ConstructWith(std::integral_constant<int, 0>, void* ptr, A const&,
+                   Args&&... args) {
+  ::new (ptr) T(std::forward<Args>(args)...);
+}
+
+template <class T, class A, class... Args>
+void ConstructWith(std::integral_constant<int, 1>, void* ptr, A const& alloc,
+                   Args&&... args) {
+  ::new (ptr) T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+}
+
+template <class T, class A, class... Args>
+void ConstructWith(std::integral_constant<int, 2>, void* ptr, A const& alloc,
+                   Args&&... args) {
+  ::new (ptr) T(std::forward<Args>(args)..., alloc);
+}
+
+template <class T, class A, class... Args>
+void ConstructUsingAllocator(void* ptr, A const& alloc, Args&&... args) {
+  constexpr int kForm =
+      !std::uses_allocator<T, A>::value ? 0
+      : std::is_constructible<T, std::allocator_arg_t, A const&,
+                              Args...>::value
+          ? 1
+          : 2;
+  ConstructWith<T>(std::integral_constant<int, kForm>(), ptr, alloc,
+                   std::forward<Args>(args)...);
+}
+
+template <class T, class A, class = meta::VoidType<>>
+struct HasAllocatorOf : std::false_type {};
+
+template <class T, class A>
+struct HasAllocatorOf<
+    T, A, meta::VoidType<decltype(std::declval<T const&>().get_allocator())>>
+    : std::is_convertible<decltype(std::declval<T const&>().get_allocator()),
+                          A> {};
+
+// the allocator a payload was created with, or a default one
+template <class A, class T>
+auto AllocatorOf(T const& value, std::true_type) -> A {
+  return A(value.get_allocator());
+}
+
+template <class A, class T>
+auto AllocatorOf(T const&, std::false_type) -> A {
+  return A();
+}
+
+// storage of payloads with a stateful allocator. The allocator is fixed at
+// construction, like a standard container's: taken from the payload when
+// constructed from one, selected by select_on_container_copy_construction
+// on copy, moved along on move or passed as in Either(std::allocator_arg,
+// alloc, ...). Every payload constructed later, including on a change of
+// state in assignment, is constructed with it; the propagate_on_container_*
+// traits decide whether assignment replaces it.
+template <class S, class E, class A>
+class AllocatorStorage {
+ public:
+  using SuccessType = S;
+  using ErrorType = E;
+  using AllocatorType = A;
+
+ protected:
+  using Traits = std::allocator_traits<A>;
+
+  using CopyArg = std::conditional_t<
+      meta::All<std::is_copy_constructible, S, E>::value, AllocatorStorage,
+      meta::Nonesuch>;
+  using MoveArg = std::conditional_t<
+      meta::All<std::is_move_constructible, S, E>::value, AllocatorStorage,
+      meta::Nonesuch>;
+  using CopyAssignArg = std::conditional_t<
+      meta::All<std::is_copy_constructible, S, E>::value &&
+          meta::All<std::is_copy_assignable, S, E>::value,
+      AllocatorStorage, meta::Nonesuch>;
+  using MoveAssignArg = std::conditional_t<
+      meta::All<std::is_move_constructible, S, E>::value &&
+          meta::All<std::is_move_assignable, S, E>::value,
+      AllocatorStorage, meta::Nonesuch>;
+
+  AllocatorStorage(CopyArg const& that)
+      : state_(StorageState::kEmpty),
+        alloc_(Traits::select_on_container_copy_construction(that.alloc_)) {
+    CopyFrom(that);
+  }
+
+  // the moved from payload is destroyed, leaving the source empty
+  AllocatorStorage(MoveArg&& that) noexcept(
+      meta::All<std::is_nothrow_move_constructible, S, E>::value)
+      : state_(StorageState::kEmpty), alloc_(std::move(that.alloc_)) {
+    MoveFrom(that);
+  }
+
+  AllocatorStorage(A const& alloc, AllocatorStorage const& that)
+      : state_(StorageState::kEmpty), alloc_(alloc) {
+    CopyFrom(that);
+  }
+
+  AllocatorStorage(A const& alloc, AllocatorStorage&& that)
+      : state_(StorageState::kEmpty), alloc_(alloc) {
+    MoveFrom(that);
+  }
+
+  AllocatorStorage& operator=(CopyAssignArg const& that) {
+    if (this == &that) {
+      return *this;
+    }
+    Propagate(typename Traits::propagate_on_container_copy_assignment(),
+              that.alloc_);
+    if (state_ == that.state_) {
+      if (state_ == StorageState::kHasSuccess) {
+        succ_val_ = that.succ_val_;
+      } else if (state_ == StorageState::kHasError) {
+        err_val_ = that.err_val_;
+      }
+    } else {
+      Reset();
+      CopyFrom(that);
+    }
+    return *this;
+  }
+
+  AllocatorStorage& operator=(MoveAssignArg&& that) {
+    if (this == &that) {
+      return *this;
+    }
+    Propagate(typename Traits::propagate_on_container_move_assignment(),
+              that.alloc_);
+    if (state_ == that.state_) {
+      if (state_ == StorageState::kHasSuccess) {
+        succ_val_ = std::move(that.succ_val_);
+      } else if (state_ == StorageState::kHasError) {
+        err_val_ = std::move(that.err_val_);
+      }
+      that.Reset();
+    } else {
+      Reset();
+      MoveFrom(that);
+    }
+    return *this;
+  }
+
+  template <class T>
+  AllocatorStorage(SuccessTagType, T&& succ_val)
+      : state_(StorageState::kEmpty),
+        alloc_(AllocatorOf<A>(succ_val, HasAllocatorOf<S, A>())) {
+    Construct(SuccessTag, std::forward<T>(succ_val));
+  }
+
+  template <class T>
+  AllocatorStorage(ErrorTagType, T&& err_val)
+      : state_(StorageState::kEmpty),
+        alloc_(AllocatorOf<A>(err_val, HasAllocatorOf<E, A>())) {
+    Construct(ErrorTag, std::forward<T>(err_val));
+  }
+
+  explicit AllocatorStorage(EmptyType, A const& alloc = A()) noexcept(
+      std::is_nothrow_copy_constructible<A>::value)
+      : state_(StorageState::kEmpty), alloc_(alloc) {}
+
+  template <class Tag, class T>
+  AllocatorStorage(std::allocator_arg_t, A const& alloc, Tag const& tag,
+                   T&& value)
+      : state_(StorageState::kEmpty), alloc_(alloc) {
+    Construct(tag, std::forward<T>(value));
+  }
+
+  ~AllocatorStorage() noexcept(
+      meta::All<std::is_nothrow_destructible, SuccessType, ErrorType>::value) {
+    Reset();
+  }
+
+  void Reset() noexcept(
+      meta::All<std::is_nothrow_destructible, SuccessType, ErrorType>::value) {
     if (state_ == StorageState::kHasSuccess) {
       succ_val_.~SuccessType();
     } else if (state_ == StorageState::kHasError) {
       err_val_.~ErrorType();
     }
+    state_ = StorageState::kEmpty;
+  }
+
+  // payloads built with the old allocator go before it is replaced
+  void Propagate(std::true_type, A const& alloc) {
+    if (alloc_ != alloc) {
+      Reset();
+      alloc_ = alloc;
+    }
+  }
+
+  void Propagate(std::false_type, A const&) noexcept {}
+
+  // expects an empty storage
+  template <class T>
+  void Construct(SuccessTagType, T&& succ_val) {
+    ConstructUsingAllocator<SuccessType>(&succ_val_, alloc_,
+                                         std::forward<T>(succ_val));
+    state_ = StorageState::kHasSuccess;
+  }
+
+  template <class T>
+  void Construct(ErrorTagType, T&& err_val) {
+    ConstructUsingAllocator<ErrorType>(&err_val_, alloc_,
+                                       std::forward<T>(err_val));
+    state_ = StorageState::kHasError;
+  }
+
+  void CopyFrom(AllocatorStorage const& that) {
+    if (that.state_ == StorageState::kHasSuccess) {
+      Construct(SuccessTag, that.succ_val_);
+    } else if (that.state_ == StorageState::kHasError) {
+      Construct(ErrorTag, that.err_val_);
+    }
+  }
+
+  // expects an empty storage, leaves that empty
+  void MoveFrom(AllocatorStorage& that) {
+    if (that.state_ == StorageState::kHasSuccess) {
+      Construct(SuccessTag, std::move(that.succ_val_));
+    } else if (that.state_ == StorageState::kHasError) {
+      Construct(ErrorTag, std::move(that.err_val_));
+    }
+    that.Reset();
   }
 
   StorageState state_;
   union {
+    NoPayload none_;
     SuccessType succ_val_;
     ErrorType err_val_;
   };
+  A alloc_;
+};
+
+template <class S, class E, class A = EitherAllocatorType<S, E>>
+struct EitherStorage {
+  using type = AllocatorStorage<S, E, A>;
+};
+
+template <class S, class E>
+struct EitherStorage<S, E, void> {
+  using type = Storage<S, E>;
 };
 
 template <class S, class E>
@@ -233,6 +606,464 @@ struct EitherConstraints {
 
 }  // namespace detail
 
+template <class... Es>
+class ErrorUnion;
+
+// user declared error type two error types widen to in an AndThen chain,
+// specialized with a member `type` constructible from both; either order of
+// the two is found. Without one, the errors widen to an ErrorUnion.
+template <class E1, class E2>
+struct CommonError {};
+
+namespace detail {
+
+template <std::size_t I>
+using IndexConstant = std::integral_constant<std::size_t, I>;
+
+template <class...>
+struct TypeList {};
+
+constexpr std::size_t kNoIndex = static_cast<std::size_t>(-1);
+
+// position of T in Ts, kNoIndex unless it is there exactly once
+template <class T, class... Ts>
+struct IndexOf : IndexConstant<kNoIndex> {};
+
+template <class T, class... Ts>
+struct IndexOf<T, T, Ts...>
+    : IndexConstant<IndexOf<T, Ts...>::value == kNoIndex ? 0 : kNoIndex> {};
+
+template <class T, class U, class... Ts>
+struct IndexOf<T, U, Ts...>
+    : IndexConstant<IndexOf<T, Ts...>::value == kNoIndex
+                        ? kNoIndex
+                        : IndexOf<T, Ts...>::value + 1> {};
+
+// the alternatives of an ErrorUnion, one recursive union level each. Unions
+// of trivially copyable alternatives keep the implicit special members; the
+// others get an empty destructor and leave the rest to ErrorUnionStorage.
+template <bool kTrivial, class... Es>
+union ErrorCells;
+
+template <bool kTrivial>
+union ErrorCells<kTrivial> {};
+
+template <class E, class... Es>
+union ErrorCells<true, E, Es...> {
+  template <class... Args>
+  constexpr explicit ErrorCells(IndexConstant<0>, Args&&... args)
+      : head(std::forward<Args>(args)...) {}
+
+  template <std::size_t I, class... Args, class = std::enable_if_t<(I > 0)>>
+  constexpr explicit ErrorCells(IndexConstant<I>, Args&&... args)
+      : tail(IndexConstant<I - 1>(), std::forward<Args>(args)...) {}
+
+  E head;
+  ErrorCells<true, Es...> tail;
+};
+
+template <class E, class... Es>
+union ErrorCells<false, E, Es...> {
+  ErrorCells() noexcept {}
+
+  template <class... Args>
+  explicit ErrorCells(IndexConstant<0>, Args&&... args)
+      : head(std::forward<Args>(args)...) {}
+
+  template <std::size_t I, class... Args, class = std::enable_if_t<(I > 0)>>
+  explicit ErrorCells(IndexConstant<I>, Args&&... args)
+      : tail(IndexConstant<I - 1>(), std::forward<Args>(args)...) {}
+
+  ~ErrorCells() {}
+
+  E head;
+  ErrorCells<false, Es...> tail;
+};
+
+template <std::size_t I>
+struct CellAt {
+  template <class Cells>
+  static constexpr auto Get(Cells& cells) noexcept
+      -> decltype(CellAt<I - 1>::Get(cells.tail)) {
+    return CellAt<I - 1>::Get(cells.tail);
+  }
+};
+
+template <>
+struct CellAt<0> {
+  template <class Cells>
+  static constexpr auto Get(Cells& cells) noexcept -> decltype((cells.head)) {
+    return cells.head;
+  }
+};
+
+// calls f with the alternative at index, a chain of compares the optimizer
+// turns into a jump table
+template <std::size_t I, std::size_t N, bool = I + 1 == N>
+struct VisitCell {
+  template <class Cells, class F>
+  static constexpr auto Apply(std::size_t index, Cells& cells, F&& f)
+      -> decltype(std::forward<F>(f)(CellAt<I>::Get(cells))) {
+    return index == I ? std::forward<F>(f)(CellAt<I>::Get(cells))
+                      : VisitCell<I + 1, N>::Apply(index, cells,
+                                                   std::forward<F>(f));
+  }
+};
+
+template <std::size_t I, std::size_t N>
+struct VisitCell<I, N, true> {
+  template <class Cells, class F>
+  static constexpr auto Apply(std::size_t, Cells& cells, F&& f)
+      -> decltype(std::forward<F>(f)(CellAt<I>::Get(cells))) {
+    return std::forward<F>(f)(CellAt<I>::Get(cells));
+  }
+};
+
+template <class... Es>
+using ErrorCellsOf =
+    ErrorCells<meta::All<std::is_trivially_copyable, Es...>::value, Es...>;
+
+// default case for trivially copyable alternatives, see Storage
+template <bool, class... Es>
+class ErrorUnionStorage {
+ protected:
+  template <std::size_t I, class... Args>
+  constexpr explicit ErrorUnionStorage(IndexConstant<I> index,
+                                       Args&&... args)
+      : index_(I), cells_(index, std::forward<Args>(args)...) {}
+
+  std::size_t index_;
+  ErrorCellsOf<Es...> cells_;
+};
+
+template <class... Es>
+class ErrorUnionStorage<false, Es...> {
+ protected:
+  using CopyArg = std::conditional_t<
+      meta::All<std::is_copy_constructible, Es...>::value, ErrorUnionStorage,
+      meta::Nonesuch>;
+  using MoveArg = std::conditional_t<
+      meta::All<std::is_move_constructible, Es...>::value, ErrorUnionStorage,
+      meta::Nonesuch>;
+
+  template <std::size_t I, class... Args>
+  explicit ErrorUnionStorage(IndexConstant<I> index, Args&&... args)
+      : index_(I), cells_(index, std::forward<Args>(args)...) {}
+
+  ErrorUnionStorage(CopyArg const& that) noexcept(
+      meta::All<std::is_nothrow_copy_constructible, Es...>::value)
+      : index_(that.index_) {
+    VisitCell<0, sizeof...(Es)>::Apply(index_, that.cells_,
+                                       [this](auto const& alternative) {
+                                         Emplace(alternative);
+                                       });
+  }
+
+  ErrorUnionStorage(MoveArg&& that) noexcept(
+      meta::All<std::is_nothrow_move_constructible, Es...>::value)
+      : index_(that.index_) {
+    VisitCell<0, sizeof...(Es)>::Apply(index_, that.cells_,
+                                       [this](auto& alternative) {
+                                         Emplace(std::move(alternative));
+                                       });
+  }
+
+  // assigning through a temporary keeps the alternatives' assignment
+  // operators out of it, so a change of alternative is handled once
+  ErrorUnionStorage& operator=(CopyArg const& that) {
+    if (this != &that) {
+      auto copy = ErrorUnionStorage(that);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  ErrorUnionStorage& operator=(MoveArg&& that) noexcept(
+      meta::All<std::is_nothrow_move_constructible, Es...>::value) {
+    if (this != &that) {
+      Destroy();
+      index_ = that.index_;
+      VisitCell<0, sizeof...(Es)>::Apply(index_, that.cells_,
+                                         [this](auto& alternative) {
+                                           Emplace(std::move(alternative));
+                                         });
+    }
+    return *this;
+  }
+
+  ~ErrorUnionStorage() { Destroy(); }
+
+  // constructs the alternative of type T, which index_ already names
+  template <class T>
+  void Emplace(T&& value) {
+    using Alternative = std::decay_t<T>;
+    ::new (static_cast<void*>(&CellAt<IndexOf<Alternative, Es...>::value>::Get(
+        cells_))) Alternative(std::forward<T>(value));
+  }
+
+  void Destroy() noexcept {
+    VisitCell<0, sizeof...(Es)>::Apply(
+        index_, cells_, [](auto& alternative) {
+          using Alternative = std::decay_t<decltype(alternative)>;
+          alternative.~Alternative();
+        });
+  }
+
+  std::size_t index_;
+  ErrorCellsOf<Es...> cells_;
+};
+
+}  // namespace detail
+
+// one of several error types, tagged by the index of the alternative it
+// holds. It is what errors of different types widen to along an AndThen
+// chain, so each step's error is moved in once and the chain needs no
+// hand written union of its error types. Trivially copyable, and usable in
+// constant expressions, when all alternatives are.
+template <class... Es>
+class ErrorUnion final
+    : private detail::ErrorUnionStorage<
+          detail::meta::All<std::is_trivially_copyable, Es...>::value, Es...> {
+  static_assert(sizeof...(Es) > 0, "[et::ErrorUnion] no alternatives");
+  static_assert(detail::meta::All<std::is_object, Es...>::value,
+                "[et::ErrorUnion] only object types supported");
+  static_assert(detail::meta::Non<std::is_const, Es...>::value,
+                "[et::ErrorUnion] const alternatives not supported");
+  static_assert(detail::meta::Conjuction<(detail::IndexOf<Es, Es...>::value !=
+                                          detail::kNoIndex)...>::value,
+                "[et::ErrorUnion] alternatives must be distinct");
+  // an assignment changing the alternative cannot be undone halfway
+  static_assert(
+      detail::meta::All<std::is_nothrow_move_constructible, Es...>::value,
+      "[et::ErrorUnion] alternatives must be nothrow move constructible");
+
+  template <class... Fs>
+  friend class ErrorUnion;
+
+  using Base = detail::ErrorUnionStorage<
+      detail::meta::All<std::is_trivially_copyable, Es...>::value, Es...>;
+
+  template <class T>
+  using IndexOf = detail::IndexOf<std::decay_t<T>, Es...>;
+
+ public:
+  static constexpr std::size_t kAlternatives = sizeof...(Es);
+
+  // from any alternative, each of which appears once
+  template <class T,
+            class = std::enable_if_t<IndexOf<T>::value != detail::kNoIndex>>
+  constexpr ErrorUnion(T&& value) noexcept(
+      std::is_nothrow_constructible<std::decay_t<T>, T&&>::value)
+      : Base(detail::IndexConstant<IndexOf<T>::value>(),
+             std::forward<T>(value)) {}
+
+  // from an ErrorUnion of a subset of the alternatives
+  template <class... Fs,
+            class = std::enable_if_t<!std::is_same<ErrorUnion<Fs...>,
+                                                   ErrorUnion>::value &&
+                                     detail::meta::Conjuction<
+                                         (detail::IndexOf<Fs, Es...>::value !=
+                                          detail::kNoIndex)...>::value>>
+  constexpr ErrorUnion(ErrorUnion<Fs...> const& that)
+      : ErrorUnion(detail::VisitCell<0, sizeof...(Fs)>::Apply(
+            that.index_, that.cells_,
+            [](auto const& alternative) { return ErrorUnion(alternative); })) {}
+
+  template <class... Fs,
+            class = std::enable_if_t<!std::is_same<ErrorUnion<Fs...>,
+                                                   ErrorUnion>::value &&
+                                     detail::meta::Conjuction<
+                                         (detail::IndexOf<Fs, Es...>::value !=
+                                          detail::kNoIndex)...>::value>>
+  constexpr ErrorUnion(ErrorUnion<Fs...>&& that)
+      : ErrorUnion(detail::VisitCell<0, sizeof...(Fs)>::Apply(
+            that.index_, that.cells_, [](auto& alternative) {
+              return ErrorUnion(std::move(alternative));
+            })) {}
+
+  constexpr auto Index() const noexcept -> std::size_t { return this->index_; }
+
+  template <class T>
+  constexpr auto Holds() const noexcept -> bool {
+    static_assert(IndexOf<T>::value != detail::kNoIndex,
+                  "[et::ErrorUnion::Holds] not an alternative");
+    return this->index_ == IndexOf<T>::value;
+  }
+
+  template <class T>
+  constexpr auto Get() & -> T& {
+    return Holds<T>()
+               ? detail::CellAt<IndexOf<T>::value>::Get(this->cells_)
+               : (throw BadEitherAccess(
+                     "[et::ErrorUnion::Get] invalid alternative access"));
+  }
+
+  template <class T>
+  constexpr auto Get() const& -> T const& {
+    return Holds<T>()
+               ? detail::CellAt<IndexOf<T>::value>::Get(this->cells_)
+               : (throw BadEitherAccess(
+                     "[et::ErrorUnion::Get] invalid alternative access"));
+  }
+
+  template <class T>
+  constexpr auto Get() && -> T&& {
+    return Holds<T>()
+               ? std::move(
+                     detail::CellAt<IndexOf<T>::value>::Get(this->cells_))
+               : (throw BadEitherAccess(
+                     "[et::ErrorUnion::Get] invalid alternative access"));
+  }
+
+  // f is called with the held alternative and returns the same type for all
+  template <class F>
+  constexpr auto Visit(F&& f) const& -> decltype(
+      detail::VisitCell<0, sizeof...(Es)>::Apply(
+          0, std::declval<detail::ErrorCellsOf<Es...> const&>(),
+          std::forward<F>(f))) {
+    return detail::VisitCell<0, sizeof...(Es)>::Apply(
+        this->index_, this->cells_, std::forward<F>(f));
+  }
+
+  template <class F>
+  constexpr auto Visit(F&& f) & -> decltype(
+      detail::VisitCell<0, sizeof...(Es)>::Apply(
+          0, std::declval<detail::ErrorCellsOf<Es...>&>(),
+          std::forward<F>(f))) {
+    return detail::VisitCell<0, sizeof...(Es)>::Apply(
+        this->index_, this->cells_, std::forward<F>(f));
+  }
+};
+
+template <class... Es>
+constexpr std::size_t ErrorUnion<Es...>::kAlternatives;
+
+template <class... Es>
+constexpr bool operator==(ErrorUnion<Es...> const& lhs,
+                          ErrorUnion<Es...> const& rhs) noexcept {
+  return lhs.Index() == rhs.Index() &&
+         lhs.Visit([&rhs](auto const& alternative) {
+           using Alternative = std::decay_t<decltype(alternative)>;
+           return alternative == rhs.template Get<Alternative>();
+         });
+}
+
+template <class... Es>
+constexpr bool operator!=(ErrorUnion<Es...> const& lhs,
+                          ErrorUnion<Es...> const& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <class... Es,
+          class = std::enable_if_t<detail::meta::Conjuction<
+              detail::meta::IsPrintable<Es const&>::value...>::value>>
+std::ostream& operator<<(std::ostream& os, ErrorUnion<Es...> const& e) {
+  return e.Visit(
+      [&os](auto const& alternative) -> std::ostream& {
+        return os << alternative;
+      });
+}
+
+namespace detail {
+
+template <class E>
+struct ErrorAlternatives {
+  using type = TypeList<E>;
+};
+
+template <class... Es>
+struct ErrorAlternatives<ErrorUnion<Es...>> {
+  using type = TypeList<Es...>;
+};
+
+// Ts followed by those of Us not already there
+template <class Ts, class Us>
+struct MergeAlternatives;
+
+template <class... Ts>
+struct MergeAlternatives<TypeList<Ts...>, TypeList<>> {
+  using type = TypeList<Ts...>;
+};
+
+template <class... Ts, class U, class... Us>
+struct MergeAlternatives<TypeList<Ts...>, TypeList<U, Us...>>
+    : MergeAlternatives<
+          std::conditional_t<
+              meta::Disjunction<std::is_same<Ts, U>::value...>::value,
+              TypeList<Ts...>, TypeList<Ts..., U>>,
+          TypeList<Us...>> {};
+
+template <class List>
+struct UnionOf;
+
+template <class E>
+struct UnionOf<TypeList<E>> {
+  using type = E;
+};
+
+template <class... Es>
+struct UnionOf<TypeList<Es...>> {
+  using type = ErrorUnion<Es...>;
+};
+
+template <class E1, class E2, class = meta::VoidType<>>
+struct ReversedCommonError
+    : UnionOf<typename MergeAlternatives<
+          typename ErrorAlternatives<E1>::type,
+          typename ErrorAlternatives<E2>::type>::type> {};
+
+template <class E1, class E2>
+struct ReversedCommonError<E1, E2,
+                           meta::VoidType<typename CommonError<E2, E1>::type>> {
+  using type = typename CommonError<E2, E1>::type;
+};
+
+template <class E1, class E2, class = meta::VoidType<>>
+struct WidenedError : ReversedCommonError<E1, E2> {};
+
+template <class E1, class E2>
+struct WidenedError<E1, E2,
+                    meta::VoidType<typename CommonError<E1, E2>::type>> {
+  using type = typename CommonError<E1, E2>::type;
+};
+
+// a step that cannot fail keeps the error type
+template <class E>
+struct WidenedError<E, void> {
+  using type = E;
+};
+
+template <class W, class E>
+constexpr auto WidenTo(E&& err_val) -> W {
+  return W(std::forward<E>(err_val));
+}
+
+template <class E, class R>
+struct AndThenResult {
+  static_assert(!std::is_same<R, R>::value,
+                "[et::Either::AndThen] the function must return an Either");
+};
+
+template <class E, class S2, class E2>
+struct AndThenResult<E, Either<S2, E2>> {
+  static_assert(meta::NotVoid<S2>::value,
+                "[et::Either::AndThen] the function must return an Either "
+                "with a success type");
+  using type = Either<S2, typename WidenedError<E, E2>::type>;
+};
+
+// Either a step of an AndThen chain calling f with Arg results in
+template <class F, class Arg, class E>
+using AndThenType = typename AndThenResult<
+    E, std::decay_t<decltype(std::declval<F>()(std::declval<Arg>()))>>::type;
+
+}  // namespace detail
+
+// error type of an AndThen step failing with E1 followed by one failing
+// with E2
+template <class E1, class E2>
+using WidenedError = typename detail::WidenedError<E1, E2>::type;
+
 template <class S>
 class Either<S, void> final : detail::EitherConstraints<S, void> {
  public:
@@ -246,7 +1077,7 @@ class Either<S, void> final : detail::EitherConstraints<S, void> {
       : succ_val_(succ_val) {}
 
   explicit constexpr Either(SuccessType&& succ_val) noexcept(
-      std::is_nothrow_move_constructible<ErrorType>::value)
+      std::is_nothrow_move_constructible<SuccessType>::value)
       : succ_val_(std::move(succ_val)) {}
 
   constexpr auto IsSuccess() const noexcept -> bool { return true; }
@@ -254,7 +1085,7 @@ class Either<S, void> final : detail::EitherConstraints<S, void> {
 
   constexpr operator bool() const noexcept { return true; }
 
-  //  constexpr auto Success() & noexcept -> SuccessType& { return succ_val_; }
+  constexpr auto Success() & noexcept -> SuccessType& { return succ_val_; }
   constexpr auto Success() const& noexcept -> SuccessType const& {
     return succ_val_;
   }
@@ -299,7 +1130,7 @@ class Either<void, E> : private detail::EitherConstraints<void, E> {
     throw BadEitherAccess("[et::Either<void, E>::Success]");
   }
 
-  //  constexpr auto Error() & noexcept -> ErrorType& { return err_val_; }
+  constexpr auto Error() & noexcept -> ErrorType& { return err_val_; }
   constexpr auto Error() const& noexcept -> ErrorType const& {
     return err_val_;
   }
@@ -325,11 +1156,51 @@ constexpr auto Error(EE&& err_val) {
   return Either<void, std::decay_t<EE>>(std::forward<EE>(err_val));
 }
 
+namespace detail {
+
+// the result of an AndThen step as the chain's Either, moved through
+// unchanged when the step already fails with the widened error type
+template <class Result>
+constexpr auto WidenEither(std::true_type, Result&& result) -> Result {
+  return std::move(result);
+}
+
+template <class Result, class S2, class E2>
+constexpr auto WidenEither(std::false_type, Either<S2, E2>&& result)
+    -> Result {
+  return result.IsSuccess()
+             ? Result(Either<S2, void>(std::move(result).Success()))
+             : Result(Error(WidenTo<typename Result::ErrorType>(
+                   std::move(result).Error())));
+}
+
+template <class Result, class S2>
+constexpr auto WidenEither(std::false_type, Either<S2, void>&& result)
+    -> Result {
+  return Result(std::move(result));
+}
+
+}  // namespace detail
+
 template <class S, class E>
-class Either final : private detail::Storage<S, E>,
-                     detail::EitherConstraints<S, E> {
+class Either final
+    : private detail::EitherStorage<S, E>::type,
+      detail::EitherConstraints<S, E>,
+      public detail::EitherAllocatorTypedef<detail::EitherAllocatorType<S, E>> {
  private:
-  using Base = detail::Storage<S, E>;
+  using Base = typename detail::EitherStorage<S, E>::type;
+
+  // payloads with a stateful allocator_type keep it in the storage
+  using AllocatorAware = std::integral_constant<
+      bool, !std::is_void<detail::EitherAllocatorType<S, E>>::value>;
+
+  template <class Alloc, class B>
+  using EnableIfAllocator = std::enable_if_t<
+      std::is_convertible<Alloc const&, typename B::AllocatorType>::value>;
+
+  // trivially copyable payloads are cheaper to overwrite as a whole
+  static constexpr bool kAssignInPlace =
+      !detail::meta::All<std::is_trivially_copyable, S, E>::value;
 
  public:
   using SuccessType = typename Base::SuccessType;
@@ -337,34 +1208,16 @@ class Either final : private detail::Storage<S, E>,
 
   constexpr operator bool() const noexcept { return this->IsSuccess(); }
 
-  template <class BB = Base,
-            class = std::enable_if_t<std::is_copy_assignable<BB>::value>>
-  constexpr Either(Either const& that) noexcept(
-      std::is_nothrow_copy_assignable<Base>::value) {
-    *this = that;
-  }
-
-  template <class BB = Base,
-            class = std::enable_if_t<std::is_move_assignable<BB>::value>>
-  constexpr Either(Either&& that) noexcept(
-      std::is_move_assignable<Base>::value) {
-    *this = std::move(that);
-  }
+  // copy and move are the implicit ones of Base: trivial, and so usable in
+  // constant expressions, for trivially copyable payloads
 
-  template <class BB = Base,
-            class = std::enable_if_t<std::is_copy_assignable<BB>::value>>
-  constexpr Either& operator=(Either const& that) noexcept(
-      std::is_nothrow_copy_assignable<Base>::value) {
-    static_cast<Base>(*this) = static_cast<Base const&>(that);
-    return *this;
-  }
+  // empty, so that result buffers can be allocated up front (resize,
+  // std::make_unique<Either[]>) and their slots filled by assignment later,
+  // from several threads as long as each slot has a single writer. Only the
+  // state is written.
+  constexpr Either() noexcept : Base(empty) {}
 
-  template <class BB = Base,
-            class = std::enable_if_t<std::is_move_assignable<BB>::value>>
-  constexpr Either& operator=(Either&& that) {
-    static_cast<Base>(*this) = static_cast<Base&&>(that);
-    return *this;
-  }
+  constexpr Either(EmptyType) noexcept : Base(empty) {}
 
   // conversion constructors
   template <class SS = SuccessType,
@@ -377,8 +1230,7 @@ class Either final : private detail::Storage<S, E>,
             class = std::enable_if_t<std::is_move_constructible<SS>::value>>
   constexpr Either(Either<SuccessType, void>&& that) noexcept(
       std::is_nothrow_move_constructible<SuccessType>::value)
-      : Base(detail::SuccessTag,
-             static_cast<Either<SuccessType, void>>(that).Success()) {}
+      : Base(detail::SuccessTag, std::move(that).Success()) {}
 
   template <class EE = ErrorType,
             class = std::enable_if_t<std::is_copy_constructible<EE>::value>>
@@ -390,58 +1242,111 @@ class Either final : private detail::Storage<S, E>,
             class = std::enable_if_t<std::is_move_constructible<EE>::value>>
   constexpr Either(Either<void, ErrorType>&& that) noexcept(
       std::is_nothrow_move_constructible<ErrorType>::value)
-      : Base(detail::ErrorTag,
-             static_cast<Either<void, ErrorType>>(that).Error()) {}
+      : Base(detail::ErrorTag, std::move(that).Error()) {}
+
+  // allocator extended constructors, for uses allocator construction
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc) noexcept
+      : Base(empty, typename B::AllocatorType(alloc)) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc, EmptyType) noexcept
+      : Base(empty, typename B::AllocatorType(alloc)) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc, Either const& that)
+      : Base(typename B::AllocatorType(alloc), that) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc, Either&& that)
+      : Base(typename B::AllocatorType(alloc), std::move(that)) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc,
+         Either<SuccessType, void> const& that)
+      : Base(std::allocator_arg, typename B::AllocatorType(alloc),
+             detail::SuccessTag, that.Success()) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc,
+         Either<SuccessType, void>&& that)
+      : Base(std::allocator_arg, typename B::AllocatorType(alloc),
+             detail::SuccessTag, std::move(that).Success()) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc,
+         Either<void, ErrorType> const& that)
+      : Base(std::allocator_arg, typename B::AllocatorType(alloc),
+             detail::ErrorTag, that.Error()) {}
+
+  template <class Alloc, class B = Base, class = EnableIfAllocator<Alloc, B>>
+  Either(std::allocator_arg_t, Alloc const& alloc,
+         Either<void, ErrorType>&& that)
+      : Base(std::allocator_arg, typename B::AllocatorType(alloc),
+             detail::ErrorTag, std::move(that).Error()) {}
+
+  template <class B = Base>
+  auto get_allocator() const noexcept -> typename B::AllocatorType {
+    return this->alloc_;
+  }
 
-  // conversion assignment
+  // conversion assignment assigns a non trivial payload in place when the
+  // state does not change and otherwise goes through a converted temporary,
+  // so an inactive union member is never assigned to
   template <class SS = SuccessType,
-            class = std::enable_if_t<std::is_copy_assignable<SS>::value>>
+            class = std::enable_if_t<std::is_copy_constructible<SS>::value &&
+                                     std::is_copy_assignable<SS>::value>>
   constexpr Either& operator=(Either<SuccessType, void> const& that) noexcept(
-      detail::meta::Conjuction<
-          std::is_nothrow_destructible<Base>::value,
-          std::is_nothrow_copy_assignable<SuccessType>::value>::value) {
-    this->state_ = detail::StorageState::kHasSuccess;
-    this->succ_val_ = that.Success();
-
-    return *this;
+      std::is_nothrow_copy_constructible<SuccessType>::value&&
+          std::is_nothrow_copy_assignable<SuccessType>::value&&
+              std::is_nothrow_move_assignable<Either>::value) {
+    if (kAssignInPlace && this->IsSuccess()) {
+      this->succ_val_ = that.Success();
+      return *this;
+    }
+    return *this = Converted(AllocatorAware(), that);
   }
 
   template <class SS = SuccessType,
-            class = std::enable_if_t<std::is_move_assignable<SS>::value>>
+            class = std::enable_if_t<std::is_move_constructible<SS>::value &&
+                                     std::is_move_assignable<SS>::value>>
   constexpr Either& operator=(Either<SuccessType, void>&& that) noexcept(
-      detail::meta::Conjuction<
-          std::is_nothrow_destructible<Base>::value,
-          std::is_nothrow_move_assignable<SuccessType>::value>::value) {
-    this->state_ = detail::StorageState::kHasError;
-    this->succ_val_ =
-        std::move(static_cast<Either<SuccessType, void>&&>(that).Success());
-
-    return *this;
+      std::is_nothrow_move_constructible<SuccessType>::value&&
+          std::is_nothrow_move_assignable<SuccessType>::value&&
+              std::is_nothrow_move_assignable<Either>::value) {
+    if (kAssignInPlace && this->IsSuccess()) {
+      this->succ_val_ = std::move(that).Success();
+      return *this;
+    }
+    return *this = Converted(AllocatorAware(), std::move(that));
   }
 
   template <class EE = ErrorType,
-            std::enable_if_t<std::is_copy_assignable<EE>::value>>
+            class = std::enable_if_t<std::is_copy_constructible<EE>::value &&
+                                     std::is_copy_assignable<EE>::value>>
   constexpr Either& operator=(Either<void, ErrorType> const& that) noexcept(
-      detail::meta::Conjuction<
-          std::is_nothrow_destructible<Base>::value,
-          std::is_nothrow_copy_assignable<ErrorType>::value>::value) {
-    this->state_ = detail::StorageState::kHasError;
-    this->err_val_ = that.Error();
-
-    return *this;
+      std::is_nothrow_copy_constructible<ErrorType>::value&&
+          std::is_nothrow_copy_assignable<ErrorType>::value&&
+              std::is_nothrow_move_assignable<Either>::value) {
+    if (kAssignInPlace && this->IsError()) {
+      this->err_val_ = that.Error();
+      return *this;
+    }
+    return *this = Converted(AllocatorAware(), that);
   }
 
   template <class EE = ErrorType,
-            std::enable_if_t<std::is_move_assignable<EE>::value>>
+            class = std::enable_if_t<std::is_move_constructible<EE>::value &&
+                                     std::is_move_assignable<EE>::value>>
   constexpr Either& operator=(Either<void, ErrorType>&& that) noexcept(
-      detail::meta::Conjuction<
-          std::is_nothrow_destructible<Base>::value,
-          std::is_nothrow_move_assignable<ErrorType>::value>::value) {
-    this->steate_ = detail::StorageState::kHasError;
-    this->err_val_ =
-        std::move(static_cast<Either<void, ErrorType>&&>(that).Error());
-
-    return *this;
+      std::is_nothrow_move_constructible<ErrorType>::value&&
+          std::is_nothrow_move_assignable<ErrorType>::value&&
+              std::is_nothrow_move_assignable<Either>::value) {
+    if (kAssignInPlace && this->IsError()) {
+      this->err_val_ = std::move(that).Error();
+      return *this;
+    }
+    return *this = Converted(AllocatorAware(), std::move(that));
   }
 
   // Access
@@ -451,13 +1356,16 @@ class Either final : private detail::Storage<S, E>,
   constexpr auto IsError() const noexcept -> bool {
     return this->state_ == detail::StorageState::kHasError;
   }
+  constexpr auto IsEmpty() const noexcept -> bool {
+    return this->state_ == detail::StorageState::kEmpty;
+  }
 
-  //  constexpr auto Success() & -> SuccessType& {
-  //    return this->state_ == detail::StorageState::kHasSuccess
-  //               ? this->succ_val_
-  //               : (throw BadEitherAccess(
-  //                     "[et::Either<S, E>::Success] invalid state access"));
-  //  }
+  constexpr auto Success() & -> SuccessType& {
+    return this->state_ == detail::StorageState::kHasSuccess
+               ? this->succ_val_
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Success] invalid state access"));
+  }
 
   constexpr auto Success() const& -> SuccessType const& {
     return this->state_ == detail::StorageState::kHasSuccess
@@ -467,29 +1375,25 @@ class Either final : private detail::Storage<S, E>,
   }
 
   constexpr auto Success() && -> SuccessType&& {
-    if (this->state_ == detail::StorageState::kHasSuccess) {
-      this->state_ = detail::StorageState::kEmpty;
-      return std::move(this->succ_val_);
-    } else {
-      throw BadEitherAccess("[et::Either<S, E>::Success] invalid state access");
-    }
+    return this->state_ == detail::StorageState::kHasSuccess
+               ? std::move(this->succ_val_)
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Success] invalid state access"));
   }
 
   constexpr auto Success() const&& -> SuccessType const&& {
-    if (this->state_ == detail::StorageState::kHasSuccess) {
-      this->state_ = detail::StorageState::kEmpty;
-      return std::move(this->succ_val_);
-    } else {
-      throw BadEitherAccess("[et::Either<S, E>::Success] invalid state access");
-    }
+    return this->state_ == detail::StorageState::kHasSuccess
+               ? std::move(this->succ_val_)
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Success] invalid state access"));
   }
 
-  //  constexpr auto Error() & -> ErrorType& {
-  //    return this->state_ == detail::StorageState::kHasError
-  //               ? this->err_val_
-  //               : (throw BadEitherAccess(
-  //                     "[et::Either<S, E>::Error] invalid state access"));
-  //  }
+  constexpr auto Error() & -> ErrorType& {
+    return this->state_ == detail::StorageState::kHasError
+               ? this->err_val_
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Error] invalid state access"));
+  }
 
   constexpr auto Error() const& -> ErrorType const& {
     return this->state_ == detail::StorageState::kHasError
@@ -499,58 +1403,99 @@ class Either final : private detail::Storage<S, E>,
   }
 
   constexpr auto Error() && -> ErrorType&& {
-    if (this->state_ == detail::StorageState::kHasError) {
-      this->state_ = detail::StorageState::kEmpty;
-      return std::move(this->err_val_);
-    } else {
-      throw BadEitherAccess("[et::Either<S, E>::Error] invalid state access");
-    }
+    return this->state_ == detail::StorageState::kHasError
+               ? std::move(this->err_val_)
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Error] invalid state access"));
   }
 
   constexpr auto Error() const&& -> ErrorType const&& {
-    if (this->state_ == detail::StorageState::kHasError) {
-      this->state_ = detail::StorageState::kEmpty;
-      return std::move(this->err_val_);
-    } else {
-      throw BadEitherAccess("[et::Either<S, E>::Error] invalid state access");
-    }
+    return this->state_ == detail::StorageState::kHasError
+               ? std::move(this->err_val_)
+               : (throw BadEitherAccess(
+                     "[et::Either<S, E>::Error] invalid state access"));
   }
-};
 
-template <class S, class E>
-bool operator==(Either<S, E> const& lhs, Either<S, E> const& rhs) noexcept;
+  // Chaining
+  // f takes the success value and returns an Either<S2, E2>, or an
+  // Either<S2, void> for a step that cannot fail. The chain continues as
+  // Either<S2, WidenedError<E, E2>>: E when E2 is E, the CommonError of the
+  // two when declared, else an ErrorUnion of both. Errors are moved into the
+  // widened type without any conversion of their own.
+  template <class F>
+  constexpr auto AndThen(F&& f) const&
+      -> detail::AndThenType<F, SuccessType const&, ErrorType> {
+    using Result = detail::AndThenType<F, SuccessType const&, ErrorType>;
+    using Returned =
+        std::decay_t<decltype(std::forward<F>(f)(this->succ_val_))>;
+    return IsSuccess()
+               ? detail::WidenEither<Result>(
+                     std::is_same<Result, Returned>(),
+                     std::forward<F>(f)(this->succ_val_))
+               : Result(et::Error(
+                     detail::WidenTo<typename Result::ErrorType>(Error())));
+  }
+
+  template <class F>
+  constexpr auto AndThen(F&& f) && -> detail::AndThenType<F, SuccessType&&,
+                                                          ErrorType> {
+    using Result = detail::AndThenType<F, SuccessType&&, ErrorType>;
+    using Returned = std::decay_t<decltype(std::forward<F>(f)(
+        std::move(this->succ_val_)))>;
+    return IsSuccess()
+               ? detail::WidenEither<Result>(
+                     std::is_same<Result, Returned>(),
+                     std::forward<F>(f)(std::move(this->succ_val_)))
+               : Result(et::Error(detail::WidenTo<typename Result::ErrorType>(
+                     std::move(*this).Error())));
+  }
+
+ private:
+  // the temporary a conversion assignment moves from, its payload already
+  // constructed with the allocator this keeps
+  template <class T>
+  static constexpr auto Converted(std::false_type, T&& that) -> Either {
+    return Either(std::forward<T>(that));
+  }
+
+  template <class T>
+  auto Converted(std::true_type, T&& that) const -> Either {
+    return Either(std::allocator_arg, this->alloc_, std::forward<T>(that));
+  }
+};
 
 template <class S>
-bool operator==(Either<S, void> const& lhs,
-                Either<S, void> const& rhs) noexcept {
+constexpr bool operator==(Either<S, void> const& lhs,
+                          Either<S, void> const& rhs) noexcept {
   return lhs.Success() == rhs.Success();
 }
 
 template <class E>
-bool operator==(Either<void, E> const& lhs,
-                Either<void, E> const& rhs) noexcept {
-  return rhs.Error() == rhs.Error();
+constexpr bool operator==(Either<void, E> const& lhs,
+                          Either<void, E> const& rhs) noexcept {
+  return lhs.Error() == rhs.Error();
 }
 
 template <class S, class E>
-bool operator==(Either<S, void> const& lhs,
-                Either<void, E> const& rhs) noexcept {
+constexpr bool operator==(Either<S, void> const&,
+                          Either<void, E> const&) noexcept {
   return false;
 }
 
+// two empty values compare equal
 template <class S, class E>
-bool operator==(Either<S, E> const& lhs, Either<S, E> const& rhs) noexcept {
-  if (lhs.IsSuccess() && rhs.IsSuccess()) {
-    return lhs.Success() == rhs.Success();
-  } else if (lhs.IsError() == rhs.IsError()) {
-    return lhs.Error() == rhs.Error();
-  }
-
-  return false;
+constexpr bool operator==(Either<S, E> const& lhs,
+                          Either<S, E> const& rhs) noexcept {
+  // every access is guarded by its own state check so the throws fold away
+  return lhs.IsSuccess()
+             ? rhs.IsSuccess() && lhs.Success() == rhs.Success()
+         : lhs.IsError() ? rhs.IsError() && lhs.Error() == rhs.Error()
+                         : !rhs.IsSuccess() && !rhs.IsError();
 }
 
 template <class S, class E>
-bool operator!=(Either<S, E> const& lhs, Either<S, E> const& rhs) noexcept {
+constexpr bool operator!=(Either<S, E> const& lhs,
+                          Either<S, E> const& rhs) noexcept {
   return !(lhs == rhs);
 }
 
@@ -563,7 +1508,7 @@ std::ostream& operator<<(std::ostream& os, Either<S, void> const& e) {
 }
 
 template <class E>
-std::ostream& operator<<(std::ostream& os, Either<void, E> const e) {
+std::ostream& operator<<(std::ostream& os, Either<void, E> const& e) {
   return os << e.Error();
 }
 
@@ -575,8 +1520,61 @@ std::ostream& operator<<(std::ostream& os, Either<S, E> const& e) {
     return os << e.Error();
   }
 }
+
+namespace detail {
+
+// keeps a success and an error holding equal payloads apart
+constexpr auto MixErrorHash(std::size_t hash) noexcept -> std::size_t {
+  return hash ^ (static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) +
+                 (hash << 6U) + (hash >> 2U));
+}
+
+// disabled unless both payloads are hashable, as std::hash requires
+template <class S, class E,
+          bool = meta::All<meta::IsStdHashableOrVoid, S, E>::value>
+struct EitherHash {
+  EitherHash() = delete;
+  EitherHash(EitherHash const&) = delete;
+  EitherHash& operator=(EitherHash const&) = delete;
+};
+
+template <class S>
+struct EitherHash<S, void, true> {
+  auto operator()(Either<S, void> const& e) const -> std::size_t {
+    return std::hash<S>()(e.Success());
+  }
+};
+
+template <class E>
+struct EitherHash<void, E, true> {
+  auto operator()(Either<void, E> const& e) const -> std::size_t {
+    return MixErrorHash(std::hash<E>()(e.Error()));
+  }
+};
+
+template <class S, class E>
+struct EitherHash<S, E, true> {
+  auto operator()(Either<S, E> const& e) const -> std::size_t {
+    if (e.IsSuccess()) {
+      return std::hash<S>()(e.Success());
+    } else if (e.IsError()) {
+      return MixErrorHash(std::hash<E>()(e.Error()));
+    }
+    return 0;
+  }
+};
+
+}  // namespace detail
+
 }  // namespace et
 
+namespace std {
+
+template <class S, class E>
+struct hash<::et::Either<S, E>> : ::et::detail::EitherHash<S, E> {};
+
+}  // namespace std
+
 namespace et {
 namespace detail {
 namespace asserts {
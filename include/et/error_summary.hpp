@@ -0,0 +1,233 @@
+#ifndef ET_ERROR_SUMMARY_HPP_
+#define ET_ERROR_SUMMARY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// an error among the heaviest seen: it occurred at most count and at least
+// count - overestimate times
+template <class E>
+struct HeavyError {
+  E error;
+  std::uint64_t count;
+  std::uint64_t overestimate;
+};
+
+template <class E>
+std::ostream& operator<<(std::ostream& os, HeavyError<E> const& heavy) {
+  return os << heavy.error << ": " << heavy.count << " (overestimate "
+            << heavy.overestimate << ")";
+}
+
+// Approximate frequency summary of the outcomes of a stream, in memory fixed
+// at construction: exact success and error counts, a count-min sketch of
+// kDepth x kWidth counters over the error hashes, answering how often an
+// error occurred within Errors() * e / kWidth with probability
+// 1 - e^-kDepth, and a space-saving table of the kTopK heaviest errors,
+// holding every error more frequent than Errors() / kTopK.
+//
+// Not synchronized: each thread adds to its own summary without locks or
+// atomics, and the summaries merge into one, e.g. once per reporting
+// interval. Summaries merge exactly for the counts and the sketch and within
+// the space-saving bounds for the top errors.
+template <class E, std::size_t kTopK = 16, std::size_t kWidth = 1024,
+          class Hash = std::hash<E>>
+class ErrorSummary {
+  static_assert(kTopK > 0, "[et::ErrorSummary] kTopK must not be 0");
+  static_assert(kWidth > 0 && (kWidth & (kWidth - 1)) == 0,
+                "[et::ErrorSummary] kWidth must be a power of two");
+
+ public:
+  static constexpr auto kDepth = std::size_t(4);
+
+  using ErrorType = E;
+  using HeavyErrorType = HeavyError<E>;
+
+  ErrorSummary() { top_.reserve(kTopK); }
+
+  template <class S>
+  void Add(Either<S, E> const& outcome) {
+    if (outcome.IsSuccess()) {
+      AddSuccess();
+    } else if (outcome.IsError()) {
+      AddError(outcome.Error());
+    }
+  }
+
+  template <class S>
+  void Add(Either<S, void> const&) noexcept {
+    AddSuccess();
+  }
+
+  void Add(Either<void, E> const& outcome) { AddError(outcome.Error()); }
+
+  void AddSuccess(std::uint64_t const count = 1) noexcept {
+    successes_ += count;
+  }
+
+  void AddError(E const& error, std::uint64_t const count = 1) {
+    errors_ += count;
+    auto const hash = static_cast<std::uint64_t>(Hash()(error));
+    AddToSketch(hash, count);
+    AddToTop(error, hash, count);
+  }
+
+  auto Successes() const noexcept -> std::uint64_t { return successes_; }
+  auto Errors() const noexcept -> std::uint64_t { return errors_; }
+  auto Total() const noexcept -> std::uint64_t { return successes_ + errors_; }
+
+  // count-min estimate, never below the true count of error
+  auto Estimate(E const& error) const -> std::uint64_t {
+    auto const hash = static_cast<std::uint64_t>(Hash()(error));
+    auto estimate = ~std::uint64_t(0);
+    for (auto row = std::size_t(0); row < kDepth; ++row) {
+      estimate = std::min(estimate, sketch_[row][Column(hash, row)]);
+    }
+    return estimate;
+  }
+
+  // heaviest errors first
+  auto TopK() const -> std::vector<HeavyErrorType> {
+    auto top = std::vector<HeavyErrorType>();
+    top.reserve(top_.size());
+    for (auto const& slot : top_) {
+      top.push_back(slot.heavy);
+    }
+    std::stable_sort(top.begin(), top.end(),
+                     [](HeavyErrorType const& lhs, HeavyErrorType const& rhs) {
+                       return lhs.count > rhs.count;
+                     });
+    return top;
+  }
+
+  // adds the counts of that, as if its outcomes had been added here. An error
+  // missing from one table may have occurred up to that table's smallest
+  // count, which its bounds take on (Agarwal et al., Mergeable Summaries).
+  void Merge(ErrorSummary const& that) {
+    successes_ += that.successes_;
+    errors_ += that.errors_;
+    for (auto row = std::size_t(0); row < kDepth; ++row) {
+      for (auto column = std::size_t(0); column < kWidth; ++column) {
+        sketch_[row][column] += that.sketch_[row][column];
+      }
+    }
+
+    auto const this_floor = Floor();
+    auto const that_floor = that.Floor();
+    auto merged = std::vector<Slot>();
+    merged.reserve(top_.size() + that.top_.size());
+    for (auto const& slot : top_) {
+      auto const* const other = that.Find(slot.heavy.error, slot.hash);
+      merged.push_back(Slot{
+          HeavyErrorType{slot.heavy.error,
+                         slot.heavy.count +
+                             (other ? other->heavy.count : that_floor),
+                         slot.heavy.overestimate +
+                             (other ? other->heavy.overestimate : that_floor)},
+          slot.hash});
+    }
+    for (auto const& slot : that.top_) {
+      if (Find(slot.heavy.error, slot.hash) == nullptr) {
+        merged.push_back(Slot{
+            HeavyErrorType{slot.heavy.error, slot.heavy.count + this_floor,
+                           slot.heavy.overestimate + this_floor},
+            slot.hash});
+      }
+    }
+    std::stable_sort(merged.begin(), merged.end(),
+                     [](Slot const& lhs, Slot const& rhs) {
+                       return lhs.heavy.count > rhs.heavy.count;
+                     });
+    if (merged.size() > kTopK) {
+      merged.erase(merged.begin() + kTopK, merged.end());
+    }
+    top_.clear();
+    top_.insert(top_.end(), merged.begin(), merged.end());
+  }
+
+ private:
+  struct Slot {
+    HeavyErrorType heavy;
+    std::uint64_t hash;
+  };
+
+  // an independent column per row from the one error hash (splitmix64)
+  static auto Column(std::uint64_t const hash, std::size_t const row) noexcept
+      -> std::size_t {
+    auto z = hash + (row + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return static_cast<std::size_t>(z ^ (z >> 31U)) & (kWidth - 1);
+  }
+
+  void AddToSketch(std::uint64_t const hash, std::uint64_t const count) {
+    for (auto row = std::size_t(0); row < kDepth; ++row) {
+      sketch_[row][Column(hash, row)] += count;
+    }
+  }
+
+  void AddToTop(E const& error, std::uint64_t const hash,
+                std::uint64_t const count) {
+    auto* min = static_cast<Slot*>(nullptr);
+    for (auto& slot : top_) {
+      if (slot.hash == hash && slot.heavy.error == error) {
+        slot.heavy.count += count;
+        return;
+      }
+      if (min == nullptr || slot.heavy.count < min->heavy.count) {
+        min = &slot;
+      }
+    }
+    if (top_.size() < kTopK) {
+      top_.push_back(Slot{HeavyErrorType{error, count, 0}, hash});
+      return;
+    }
+    // the lightest error makes room, its count carries over as the bound
+    min->heavy.error = error;
+    min->heavy.overestimate = min->heavy.count;
+    min->heavy.count += count;
+    min->hash = hash;
+  }
+
+  auto Find(E const& error, std::uint64_t const hash) const -> Slot const* {
+    for (auto const& slot : top_) {
+      if (slot.hash == hash && slot.heavy.error == error) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  // most an error missing from the table can have occurred
+  auto Floor() const noexcept -> std::uint64_t {
+    if (top_.size() < kTopK) {
+      return 0;
+    }
+    auto floor = ~std::uint64_t(0);
+    for (auto const& slot : top_) {
+      floor = std::min(floor, slot.heavy.count);
+    }
+    return floor;
+  }
+
+  std::uint64_t successes_ = 0;
+  std::uint64_t errors_ = 0;
+  std::array<std::array<std::uint64_t, kWidth>, kDepth> sketch_{};
+  std::vector<Slot> top_;
+};
+
+template <class E, std::size_t kTopK, std::size_t kWidth, class Hash>
+constexpr std::size_t ErrorSummary<E, kTopK, kWidth, Hash>::kDepth;
+
+}  // namespace et
+
+#endif  // ET_ERROR_SUMMARY_HPP_
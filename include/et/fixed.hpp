@@ -0,0 +1,369 @@
+#ifndef ET_FIXED_HPP_
+#define ET_FIXED_HPP_
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "et/either.hpp"
+
+namespace et {
+
+class CapacityError {
+ public:
+  enum class Kind {
+    kFull,   // no room for another element
+    kEmpty,  // no element to take
+  };
+
+  constexpr CapacityError(Kind kind, std::size_t capacity) noexcept
+      : kind_(kind), capacity_(capacity) {}
+
+  constexpr auto GetKind() const noexcept -> Kind { return kind_; }
+  constexpr auto Capacity() const noexcept -> std::size_t { return capacity_; }
+
+ private:
+  Kind kind_;
+  std::size_t capacity_;
+};
+
+constexpr bool operator==(CapacityError const lhs,
+                          CapacityError const rhs) noexcept {
+  return lhs.GetKind() == rhs.GetKind() && lhs.Capacity() == rhs.Capacity();
+}
+
+constexpr bool operator!=(CapacityError const lhs,
+                          CapacityError const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, CapacityError const err) {
+  switch (err.GetKind()) {
+    case CapacityError::Kind::kFull:
+      return os << "full at capacity " << err.Capacity();
+    case CapacityError::Kind::kEmpty:
+      return os << "empty, capacity " << err.Capacity();
+  }
+  return os;
+}
+
+namespace detail {
+
+// uninitialized storage for N objects of type T, one after the other like an
+// array, constructed and destroyed by its container. Not copyable, so the
+// container's implicitly declared copy and move stay deleted.
+template <class T, std::size_t N>
+class FixedSlots {
+ public:
+  FixedSlots() noexcept {}
+  FixedSlots(FixedSlots const&) = delete;
+  FixedSlots& operator=(FixedSlots const&) = delete;
+
+  template <class... Args>
+  auto Construct(std::size_t const i, Args&&... args) -> T* {
+    return ::new (static_cast<void*>(bytes_ + i * sizeof(T)))
+        T(std::forward<Args>(args)...);
+  }
+
+  // the object constructed in slot i
+  auto operator[](std::size_t const i) noexcept -> T* {
+    return Launder(Address(i));
+  }
+
+  auto operator[](std::size_t const i) const noexcept -> T const* {
+    return Launder(Address(i));
+  }
+
+  // where slot i starts, whether or not it holds an object; not laundered,
+  // so valid for empty slots and one past the last, as iterator bounds
+  auto Address(std::size_t const i) noexcept -> T* {
+    return reinterpret_cast<T*>(bytes_ + i * sizeof(T));
+  }
+
+  auto Address(std::size_t const i) const noexcept -> T const* {
+    return reinterpret_cast<T const*>(bytes_ + i * sizeof(T));
+  }
+
+ private:
+  template <class U>
+  static auto Launder(U* const p) noexcept -> U* {
+#if defined(__cpp_lib_launder)
+    return std::launder(p);
+#else
+    return p;
+#endif
+  }
+
+  alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
+}  // namespace detail
+
+// Vector of at most N elements stored inline, never touching the heap. Adding
+// to a full vector or taking from an empty one is a CapacityError. Either
+// holds no references, so the element added is handed out by pointer.
+template <class T, std::size_t N>
+class FixedVector {
+  static_assert(N > 0, "[et::FixedVector] N must not be 0");
+  static_assert(std::is_object<T>::value && !std::is_const<T>::value,
+                "[et::FixedVector] T must be a non const object type");
+
+  // like Either's storage, the special members take meta::Nonesuch instead
+  // of FixedVector when T does not support them, so the implicitly deleted
+  // ones stay
+  using CopyArg =
+      std::conditional_t<std::is_copy_constructible<T>::value, FixedVector,
+                         detail::meta::Nonesuch>;
+  using MoveArg =
+      std::conditional_t<std::is_move_constructible<T>::value, FixedVector,
+                         detail::meta::Nonesuch>;
+
+ public:
+  using ValueType = T;
+  static constexpr auto kCapacity = N;
+
+  FixedVector() noexcept = default;
+
+  FixedVector(CopyArg const& that) noexcept(
+      std::is_nothrow_copy_constructible<T>::value) {
+    for (auto const& element : that) {
+      slots_.Construct(size_, element);
+      ++size_;
+    }
+  }
+
+  FixedVector(MoveArg&& that) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    for (auto& element : that) {
+      slots_.Construct(size_, std::move(element));
+      ++size_;
+    }
+  }
+
+  // the elements are replaced, so T needs no assignment
+  FixedVector& operator=(CopyArg const& that) noexcept(
+      std::is_nothrow_copy_constructible<T>::value) {
+    if (this != &that) {
+      Clear();
+      for (auto const& element : that) {
+        slots_.Construct(size_, element);
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  FixedVector& operator=(MoveArg&& that) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &that) {
+      Clear();
+      for (auto& element : that) {
+        slots_.Construct(size_, std::move(element));
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  ~FixedVector() { Clear(); }
+
+  auto TryPushBack(T const& value) -> Either<T*, CapacityError> {
+    return TryEmplaceBack(value);
+  }
+
+  auto TryPushBack(T&& value) -> Either<T*, CapacityError> {
+    return TryEmplaceBack(std::move(value));
+  }
+
+  template <class... Args>
+  auto TryEmplaceBack(Args&&... args) -> Either<T*, CapacityError> {
+    if (ET_LIKELY(size_ < N)) {
+      auto* const element =
+          slots_.Construct(size_, std::forward<Args>(args)...);
+      ++size_;
+      return Success(element);
+    }
+    return Error(CapacityError(CapacityError::Kind::kFull, N));
+  }
+
+  // the last element, moved out
+  auto TryPopBack() -> Either<T, CapacityError> {
+    if (ET_LIKELY(size_ > 0)) {
+      auto& last = *slots_[size_ - 1];
+      auto popped = Either<T, CapacityError>(Success(std::move(last)));
+      last.~T();
+      --size_;
+      return popped;
+    }
+    return Error(CapacityError(CapacityError::Kind::kEmpty, N));
+  }
+
+  void Clear() noexcept {
+    while (size_ > 0) {
+      slots_[--size_]->~T();
+    }
+  }
+
+  auto operator[](std::size_t const i) noexcept -> T& { return *slots_[i]; }
+
+  auto operator[](std::size_t const i) const noexcept -> T const& {
+    return *slots_[i];
+  }
+
+  // from the raw storage: slot 0 holds no object in an empty vector
+  auto begin() noexcept -> T* { return slots_.Address(0); }
+  auto begin() const noexcept -> T const* { return slots_.Address(0); }
+  auto end() noexcept -> T* { return slots_.Address(size_); }
+  auto end() const noexcept -> T const* { return slots_.Address(size_); }
+
+  auto Size() const noexcept -> std::size_t { return size_; }
+  auto IsEmpty() const noexcept -> bool { return size_ == 0; }
+  auto IsFull() const noexcept -> bool { return size_ == N; }
+
+ private:
+  detail::FixedSlots<T, N> slots_;
+  std::size_t size_ = 0;
+};
+
+template <class T, std::size_t N>
+constexpr std::size_t FixedVector<T, N>::kCapacity;
+
+// First in, first out queue of at most N elements stored inline, never
+// touching the heap. Like FixedVector, TryPush on a full ring and TryPop on
+// an empty one are CapacityErrors. Not synchronized.
+template <class T, std::size_t N>
+class FixedRing {
+  static_assert(N > 0, "[et::FixedRing] N must not be 0");
+  static_assert(std::is_object<T>::value && !std::is_const<T>::value,
+                "[et::FixedRing] T must be a non const object type");
+
+  // as in FixedVector
+  using CopyArg =
+      std::conditional_t<std::is_copy_constructible<T>::value, FixedRing,
+                         detail::meta::Nonesuch>;
+  using MoveArg =
+      std::conditional_t<std::is_move_constructible<T>::value, FixedRing,
+                         detail::meta::Nonesuch>;
+
+ public:
+  using ValueType = T;
+  static constexpr auto kCapacity = N;
+
+  FixedRing() noexcept = default;
+
+  // the elements are copied or moved oldest first, the new ring unwrapped
+  FixedRing(CopyArg const& that) noexcept(
+      std::is_nothrow_copy_constructible<T>::value) {
+    for (auto i = std::size_t(0); i < that.size_; ++i) {
+      slots_.Construct(i, that[i]);
+      ++size_;
+    }
+  }
+
+  FixedRing(MoveArg&& that) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    for (auto i = std::size_t(0); i < that.size_; ++i) {
+      slots_.Construct(i, std::move(that[i]));
+      ++size_;
+    }
+  }
+
+  FixedRing& operator=(CopyArg const& that) noexcept(
+      std::is_nothrow_copy_constructible<T>::value) {
+    if (this != &that) {
+      Clear();
+      for (auto i = std::size_t(0); i < that.size_; ++i) {
+        slots_.Construct(i, that[i]);
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  FixedRing& operator=(MoveArg&& that) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &that) {
+      Clear();
+      for (auto i = std::size_t(0); i < that.size_; ++i) {
+        slots_.Construct(i, std::move(that[i]));
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  ~FixedRing() { Clear(); }
+
+  auto TryPush(T const& value) -> Either<T*, CapacityError> {
+    return TryEmplace(value);
+  }
+
+  auto TryPush(T&& value) -> Either<T*, CapacityError> {
+    return TryEmplace(std::move(value));
+  }
+
+  template <class... Args>
+  auto TryEmplace(Args&&... args) -> Either<T*, CapacityError> {
+    if (ET_LIKELY(size_ < N)) {
+      auto* const element = slots_.Construct(Wrap(head_ + size_),
+                                             std::forward<Args>(args)...);
+      ++size_;
+      return Success(element);
+    }
+    return Error(CapacityError(CapacityError::Kind::kFull, N));
+  }
+
+  // the oldest element, moved out
+  auto TryPop() -> Either<T, CapacityError> {
+    if (ET_LIKELY(size_ > 0)) {
+      auto& front = *slots_[head_];
+      auto popped = Either<T, CapacityError>(Success(std::move(front)));
+      front.~T();
+      head_ = Wrap(head_ + 1);
+      --size_;
+      return popped;
+    }
+    return Error(CapacityError(CapacityError::Kind::kEmpty, N));
+  }
+
+  void Clear() noexcept {
+    while (size_ > 0) {
+      slots_[head_]->~T();
+      head_ = Wrap(head_ + 1);
+      --size_;
+    }
+    head_ = 0;
+  }
+
+  // i-th oldest element
+  auto operator[](std::size_t const i) noexcept -> T& {
+    return *slots_[Wrap(head_ + i)];
+  }
+
+  auto operator[](std::size_t const i) const noexcept -> T const& {
+    return *slots_[Wrap(head_ + i)];
+  }
+
+  auto Size() const noexcept -> std::size_t { return size_; }
+  auto IsEmpty() const noexcept -> bool { return size_ == 0; }
+  auto IsFull() const noexcept -> bool { return size_ == N; }
+
+ private:
+  // i < 2 * N, a compare instead of a division for any N
+  static auto Wrap(std::size_t const i) noexcept -> std::size_t {
+    return i < N ? i : i - N;
+  }
+
+  detail::FixedSlots<T, N> slots_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+template <class T, std::size_t N>
+constexpr std::size_t FixedRing<T, N>::kCapacity;
+
+}  // namespace et
+
+#endif  // ET_FIXED_HPP_
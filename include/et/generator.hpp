@@ -0,0 +1,457 @@
+#ifndef ET_GENERATOR_HPP_
+#define ET_GENERATOR_HPP_
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#include <optional>
+#define ET_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef ET_HAS_COROUTINES
+#define ET_HAS_COROUTINES 0
+#endif
+
+#include "et/either.hpp"
+
+namespace et {
+
+// what a generator does after handing out an error: kStop ends the sequence
+// right after it, kContinue goes on producing
+enum class ErrorPolicy { kStop, kContinue };
+
+namespace detail {
+
+template <class T>
+struct EitherParts {
+  static_assert(sizeof(T) == 0, "[et::Generator] values must be et::Either");
+};
+
+template <class S, class E>
+struct EitherParts<Either<S, E>> {
+  using SuccessType = S;
+  using ErrorType = E;
+};
+
+// consumers return void, or bool where false asks for no more values
+template <class C, class T>
+auto Consume(C& consumer, T&& value, std::true_type) -> bool {
+  consumer(std::forward<T>(value));
+  return true;
+}
+
+template <class C, class T>
+auto Consume(C& consumer, T&& value, std::false_type) -> bool {
+  return static_cast<bool>(consumer(std::forward<T>(value)));
+}
+
+template <class C, class T>
+auto Consume(C& consumer, T&& value) -> bool {
+  return Consume(consumer, std::forward<T>(value),
+                 std::is_void<decltype(consumer(std::forward<T>(value)))>());
+}
+
+template <class Source, class = meta::VoidType<>>
+struct GeneratedType {
+  using type = std::decay_t<decltype(*std::begin(std::declval<Source&>()))>;
+};
+
+template <class Source>
+struct GeneratedType<Source,
+                     meta::VoidType<typename std::decay_t<Source>::ValueType>> {
+  using type = typename std::decay_t<Source>::ValueType;
+};
+
+template <class Source, class = meta::VoidType<>>
+struct HasForEach : std::false_type {};
+
+template <class Source>
+struct HasForEach<Source,
+                  meta::VoidType<decltype(std::declval<Source&>().ForEach(
+                      std::declval<bool (&)(int)>()))>> : std::true_type {};
+
+template <class Source, class F>
+void ForEachIn(Source& source, F&& f, std::true_type) {
+  source.ForEach(std::forward<F>(f));
+}
+
+template <class Source, class F>
+void ForEachIn(Source& source, F&& f, std::false_type) {
+  for (auto&& value : source) {
+    if (!Consume(f, std::forward<decltype(value)>(value))) {
+      return;
+    }
+  }
+}
+
+}  // namespace detail
+
+// C++14 generator: the producer is invoked with a sink and calls it once per
+// value; the sink returns false once the consumer or the policy wants no
+// more values, and the producer should return then:
+//
+//   auto lines = et::MakeGenerator<et::Either<Record, ParseError>>(
+//       [&](auto& yield) {
+//         for (auto const& line : input) {
+//           if (!yield(ParseLine(line))) {
+//             return;
+//           }
+//         }
+//       });
+//   lines.ForEach([](auto&& record) { ... });
+template <class T, class F, ErrorPolicy Policy = ErrorPolicy::kStop>
+class CallbackGenerator {
+ public:
+  using ValueType = T;
+
+  explicit CallbackGenerator(F producer) : producer_(std::move(producer)) {}
+
+  // consumer(T&&) returns void, or bool where false stops the producer
+  template <class C>
+  void ForEach(C&& consumer) {
+    auto sink = Sink<std::remove_reference_t<C>>(consumer);
+    producer_(sink);
+  }
+
+ private:
+  template <class C>
+  class Sink {
+   public:
+    explicit Sink(C& consumer) noexcept : consumer_(consumer) {}
+
+    auto operator()(ValueType value) -> bool {
+      if (!open_) {
+        return false;
+      }
+      auto const stop = Policy == ErrorPolicy::kStop && value.IsError();
+      open_ = detail::Consume(consumer_, std::move(value)) && !stop;
+      return open_;
+    }
+
+   private:
+    C& consumer_;
+    bool open_ = true;
+  };
+
+  F producer_;
+};
+
+template <class T, ErrorPolicy Policy = ErrorPolicy::kStop, class F>
+auto MakeGenerator(F&& producer)
+    -> CallbackGenerator<T, std::decay_t<F>, Policy> {
+  return CallbackGenerator<T, std::decay_t<F>, Policy>(
+      std::forward<F>(producer));
+}
+
+// drains source (a generator or a range of Either<S, E>) into a vector of
+// successes, returning the first error instead if there is one; values of a
+// generator are moved, elements of an lvalue range copied
+template <class Source, class T = typename detail::GeneratedType<Source>::type,
+          class S = typename detail::EitherParts<T>::SuccessType,
+          class E = typename detail::EitherParts<T>::ErrorType>
+auto Collect(Source&& source) -> Either<std::vector<S>, E> {
+  auto result = Either<std::vector<S>, E>(Success(std::vector<S>()));
+  detail::ForEachIn(
+      source,
+      [&result](auto&& value) {
+        using Value = decltype(value);
+        if (value.IsError()) {
+          result = Error(std::forward<Value>(value).Error());
+          return false;
+        }
+        result.Success().push_back(std::forward<Value>(value).Success());
+        return true;
+      },
+      detail::HasForEach<std::remove_reference_t<Source>>());
+  return result;
+}
+
+#if ET_HAS_COROUTINES
+
+namespace detail {
+
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) FrameBlock {
+  unsigned char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+// a coroutine parameter other than the allocator, ignored by operator new.
+// GCC before 14 pairs a member template operator new with no operator
+// delete and reports -Wmismatched-new-delete in every coroutine using it, so
+// up to kMaxFrameArgs parameters go through plain functions taking these.
+struct FrameArg {
+  FrameArg() = default;
+
+  template <class U>
+  FrameArg(U const&) noexcept {}
+};
+
+inline constexpr auto kMaxFrameArgs = std::size_t(6);
+
+}  // namespace detail
+
+// C++20 coroutine generator, usable with range-for:
+//
+//   auto Records(et::MappedFile const& file)
+//       -> et::Generator<et::Either<Record, ParseError>> {
+//     for (...) {
+//       co_yield ParseLine(begin, end);
+//     }
+//   }
+//
+// The frame is allocated through Allocator. A default constructed one is
+// used unless the coroutine takes (std::allocator_arg_t, Allocator const&)
+// as its first parameters (after the object for member functions); the
+// allocator is kept at the end of the frame to release it.
+template <class T, ErrorPolicy Policy = ErrorPolicy::kStop,
+          class Allocator = std::allocator<std::byte>>
+class Generator {
+ public:
+  using ValueType = T;
+
+  class promise_type;
+  class Iterator;
+
+  Generator(Generator const&) = delete;
+  Generator& operator=(Generator const&) = delete;
+
+  Generator(Generator&& that) noexcept
+      : handle_(std::exchange(that.handle_, nullptr)) {}
+
+  Generator& operator=(Generator&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      handle_ = std::exchange(that.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Generator() { Reset(); }
+
+  // runs the coroutine up to its first value; call once
+  auto begin() -> Iterator {
+    if (handle_) {
+      Resume(handle_);
+    }
+    return Iterator(handle_);
+  }
+
+  auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+  template <class C>
+  void ForEach(C&& consumer) {
+    for (auto& value : *this) {
+      if (!detail::Consume(consumer, std::move(value))) {
+        return;
+      }
+    }
+  }
+
+  class promise_type {
+   public:
+    auto get_return_object() noexcept -> Generator {
+      return Generator(Handle::from_promise(*this));
+    }
+
+    auto initial_suspend() const noexcept -> std::suspend_always {
+      return {};
+    }
+
+    auto final_suspend() const noexcept -> std::suspend_always { return {}; }
+
+    // the yielded temporary outlives the suspension; whether to stop is
+    // decided here, the consumer may move the error out before ++
+    auto yield_value(T&& value) noexcept -> std::suspend_always {
+      current_ = std::addressof(value);
+      stop_after_ = Policy == ErrorPolicy::kStop && value.IsError();
+      return {};
+    }
+
+    auto yield_value(T const& value) -> std::suspend_always {
+      copy_.reset();
+      copy_.emplace(value);
+      current_ = std::addressof(*copy_);
+      stop_after_ = Policy == ErrorPolicy::kStop && value.IsError();
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept {
+      exception_ = std::current_exception();
+    }
+
+    // generators only yield
+    template <class U>
+    auto await_transform(U&&) -> std::suspend_never = delete;
+
+    static void* operator new(std::size_t size)
+      requires std::is_default_constructible_v<Allocator>
+    {
+      return Allocate(Allocator(), size);
+    }
+
+    static void* operator new(std::size_t size, std::allocator_arg_t,
+                              Allocator const& allocator,
+                              detail::FrameArg = {}, detail::FrameArg = {},
+                              detail::FrameArg = {}, detail::FrameArg = {},
+                              detail::FrameArg = {}, detail::FrameArg = {}) {
+      return Allocate(allocator, size);
+    }
+
+    // member coroutines, the object first
+    static void* operator new(std::size_t size, detail::FrameArg,
+                              std::allocator_arg_t, Allocator const& allocator,
+                              detail::FrameArg = {}, detail::FrameArg = {},
+                              detail::FrameArg = {}, detail::FrameArg = {},
+                              detail::FrameArg = {}, detail::FrameArg = {}) {
+      return Allocate(allocator, size);
+    }
+
+    // longer parameter lists, which older GCC warns about as above
+    template <class... Args>
+      requires(sizeof...(Args) > detail::kMaxFrameArgs)
+    static void* operator new(std::size_t size, std::allocator_arg_t,
+                              Allocator const& allocator, Args const&...) {
+      return Allocate(allocator, size);
+    }
+
+    template <class This, class... Args>
+      requires(sizeof...(Args) > detail::kMaxFrameArgs)
+    static void* operator new(std::size_t size, This const&,
+                              std::allocator_arg_t, Allocator const& allocator,
+                              Args const&...) {
+      return Allocate(allocator, size);
+    }
+
+    static void operator delete(void* frame, std::size_t size) noexcept {
+      auto* const stored = std::launder(reinterpret_cast<BlockAllocator*>(
+          static_cast<unsigned char*>(frame) + AllocatorOffset(size)));
+      auto allocator = BlockAllocator(std::move(*stored));
+      stored->~BlockAllocator();
+      BlockTraits::deallocate(allocator,
+                              static_cast<detail::FrameBlock*>(frame),
+                              Blocks(size));
+    }
+
+   private:
+    friend class Generator;
+    friend class Iterator;
+
+    using BlockAllocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<detail::FrameBlock>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+    static constexpr auto AllocatorOffset(std::size_t const size) noexcept
+        -> std::size_t {
+      return (size + alignof(BlockAllocator) - 1) &
+             ~(alignof(BlockAllocator) - 1);
+    }
+
+    static constexpr auto Blocks(std::size_t const size) noexcept
+        -> std::size_t {
+      return (AllocatorOffset(size) + sizeof(BlockAllocator) +
+              sizeof(detail::FrameBlock) - 1) /
+             sizeof(detail::FrameBlock);
+    }
+
+    static auto Allocate(Allocator const& allocator, std::size_t const size)
+        -> void* {
+      auto block_allocator = BlockAllocator(allocator);
+      auto* const frame = BlockTraits::allocate(block_allocator, Blocks(size));
+      ::new (static_cast<void*>(reinterpret_cast<unsigned char*>(frame) +
+                                AllocatorOffset(size)))
+          BlockAllocator(std::move(block_allocator));
+      return frame;
+    }
+
+    T* current_ = nullptr;
+    std::optional<T> copy_;
+    std::exception_ptr exception_;
+    bool stop_after_ = false;  // the current value is an error ending it
+    bool stopped_ = false;
+  };
+
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = T&;
+    using pointer = T*;
+
+    Iterator() = default;
+
+    auto operator*() const noexcept -> T& {
+      return *handle_.promise().current_;
+    }
+
+    auto operator->() const noexcept -> T* {
+      return handle_.promise().current_;
+    }
+
+    auto operator++() -> Iterator& {
+      auto& promise = handle_.promise();
+      if (promise.stop_after_) {
+        promise.stopped_ = true;
+      } else {
+        Resume(handle_);
+      }
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend auto operator==(Iterator const& it, std::default_sentinel_t) noexcept
+        -> bool {
+      return it.Done();
+    }
+
+   private:
+    friend class Generator;
+
+    explicit Iterator(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle) {}
+
+    auto Done() const noexcept -> bool {
+      return !handle_ || handle_.done() || handle_.promise().stopped_;
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+  };
+
+ private:
+  using Handle = std::coroutine_handle<promise_type>;
+
+  explicit Generator(Handle handle) noexcept : handle_(handle) {}
+
+  static void Resume(Handle handle) {
+    handle.resume();
+    if (ET_UNLIKELY(handle.promise().exception_)) {
+      std::rethrow_exception(std::exchange(handle.promise().exception_, {}));
+    }
+  }
+
+  void Reset() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  Handle handle_;
+};
+
+#endif  // ET_HAS_COROUTINES
+
+}  // namespace et
+
+#endif  // ET_GENERATOR_HPP_
@@ -0,0 +1,330 @@
+#ifndef ET_INIT_GRAPH_HPP_
+#define ET_INIT_GRAPH_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "et/either.hpp"
+
+namespace et {
+
+enum class InitState { kSucceeded, kFailed, kCancelled };
+
+inline std::ostream& operator<<(std::ostream& os, InitState const state) {
+  switch (state) {
+    case InitState::kSucceeded:
+      return os << "succeeded";
+    case InitState::kFailed:
+      return os << "failed";
+    case InitState::kCancelled:
+      return os << "cancelled";
+  }
+  return os;
+}
+
+// one node of a run; start is relative to the start of the run, start and
+// duration are zero for a cancelled node
+struct InitTiming {
+  std::string name;
+  InitState state;
+  std::chrono::steady_clock::duration start;
+  std::chrono::steady_clock::duration duration;
+};
+
+struct InitReport {
+  std::vector<InitTiming> nodes;  // in the order they were added
+  std::chrono::steady_clock::duration elapsed;
+
+  // nodes that ran, slowest first
+  auto Slowest() const -> std::vector<InitTiming> {
+    auto slowest = std::vector<InitTiming>();
+    for (auto const& node : nodes) {
+      if (node.state != InitState::kCancelled) {
+        slowest.push_back(node);
+      }
+    }
+    std::stable_sort(slowest.begin(), slowest.end(),
+                     [](InitTiming const& lhs, InitTiming const& rhs) {
+                       return lhs.duration > rhs.duration;
+                     });
+    return slowest;
+  }
+};
+
+inline std::ostream& operator<<(std::ostream& os, InitReport const& report) {
+  using std::chrono::microseconds;
+  using std::chrono::duration_cast;
+  os << "init " << duration_cast<microseconds>(report.elapsed).count()
+     << "us";
+  for (auto const& node : report.Slowest()) {
+    os << "\n  " << node.name << ": "
+       << duration_cast<microseconds>(node.duration).count() << "us at +"
+       << duration_cast<microseconds>(node.start).count() << "us";
+    if (node.state == InitState::kFailed) {
+      os << " (failed)";
+    }
+  }
+  return os;
+}
+
+// the first error of a run: the node chain leading to the failed node, each
+// node the dependency that finished last before the next one could start,
+// and the timing of every node, the not yet started ones cancelled
+template <class E>
+struct InitFailure {
+  E error;
+  std::vector<std::string> path;  // a root first, the failed node last
+  InitReport report;
+};
+
+template <class E>
+std::ostream& operator<<(std::ostream& os, InitFailure<E> const& failure) {
+  os << "init failed: " << failure.error << " in ";
+  for (auto i = std::size_t(0); i < failure.path.size(); ++i) {
+    os << (i == 0 ? "" : " -> ") << failure.path[i];
+  }
+  return os;
+}
+
+namespace detail {
+
+struct InitDone {};
+
+template <class E, class S, class EE>
+auto InitOutcome(Either<S, EE>&& outcome) -> Either<InitDone, E> {
+  if (outcome.IsSuccess()) {
+    return Success(InitDone());
+  }
+  // an empty outcome throws BadEitherAccess, failing the run
+  return Error(E(std::move(outcome).Error()));
+}
+
+template <class E, class S>
+auto InitOutcome(Either<S, void>&&) -> Either<InitDone, E> {
+  return Success(InitDone());
+}
+
+}  // namespace detail
+
+// Startup initializers as a dependency graph: every node is a function
+// returning an Either<S, E> (S ignored) or Either<S, void>, run once all of
+// its dependencies succeeded, independent nodes concurrently. The first
+// error stops the run: nodes not started yet are cancelled, running ones
+// finish, and Run() reports the error with its dependency path. A node
+// throwing cancels the same way and Run() rethrows the exception.
+//
+// A node depends only on nodes added before it, so the graph has no cycles.
+template <class E>
+class InitGraph {
+ public:
+  using ErrorType = E;
+  using Clock = std::chrono::steady_clock;
+
+  class Node {
+   public:
+    auto Index() const noexcept -> std::size_t { return index_; }
+
+   private:
+    friend class InitGraph;
+
+    explicit Node(std::size_t const index) noexcept : index_(index) {}
+
+    std::size_t index_;
+  };
+
+  // dependencies are nodes returned by this graph's Add
+  template <class F>
+  auto Add(std::string name, F&& init,
+           std::initializer_list<Node> const dependencies = {}) -> Node {
+    auto const node = Node(nodes_.size());
+    nodes_.push_back(Definition{
+        std::move(name),
+        [step = std::forward<F>(init)]() mutable {
+          return detail::InitOutcome<E>(step());
+        },
+        {}});
+    for (auto const dependency : dependencies) {
+      nodes_[node.index_].dependencies.push_back(dependency.index_);
+    }
+    return node;
+  }
+
+  auto Size() const noexcept -> std::size_t { return nodes_.size(); }
+
+  // runs every node on up to threads threads, 0 for one per hardware thread
+  auto Run(std::size_t threads = 0) -> Either<InitReport, InitFailure<E>> {
+    RunState run(nodes_);
+    if (threads == 0) {
+      threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, std::max<std::size_t>(nodes_.size(), 1));
+
+    auto workers = std::vector<std::thread>();
+    workers.reserve(threads - 1);
+    for (auto i = std::size_t(1); i < threads; ++i) {
+      workers.emplace_back([this, &run] { Work(run); });
+    }
+    Work(run);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (run.exception) {
+      std::rethrow_exception(run.exception);
+    }
+    auto report = InitReport{{}, Clock::now() - run.start};
+    report.nodes.reserve(nodes_.size());
+    for (auto i = std::size_t(0); i < nodes_.size(); ++i) {
+      auto const& progress = run.progress[i];
+      report.nodes.push_back(InitTiming{
+          nodes_[i].name,
+          progress.state,
+          progress.started - run.start,
+          progress.finished - progress.started,
+      });
+      if (progress.state == InitState::kCancelled) {
+        report.nodes.back().start = Clock::duration::zero();
+        report.nodes.back().duration = Clock::duration::zero();
+      }
+    }
+    if (!run.error.IsError()) {
+      return Success(std::move(report));
+    }
+
+    auto path = std::vector<std::string>();
+    for (auto i = run.failed; i != kNone; i = run.progress[i].unblocked_by) {
+      path.push_back(nodes_[i].name);
+    }
+    std::reverse(path.begin(), path.end());
+    return Error(InitFailure<E>{std::move(run.error).Error(), std::move(path),
+                                std::move(report)});
+  }
+
+ private:
+  static constexpr auto kNone = ~std::size_t(0);
+
+  struct Definition {
+    std::string name;
+    std::function<Either<detail::InitDone, E>()> init;
+    std::vector<std::size_t> dependencies;
+  };
+
+  struct Progress {
+    InitState state = InitState::kCancelled;
+    std::size_t waiting = 0;  // dependencies not finished yet
+    std::size_t unblocked_by = kNone;
+    std::vector<std::size_t> dependents;
+    Clock::time_point started;
+    Clock::time_point finished;
+  };
+
+  struct RunState {
+    explicit RunState(std::vector<Definition> const& nodes)
+        : progress(nodes.size()), start(Clock::now()) {
+      for (auto i = std::size_t(0); i < nodes.size(); ++i) {
+        progress[i].waiting = nodes[i].dependencies.size();
+        for (auto const dependency : nodes[i].dependencies) {
+          progress[dependency].dependents.push_back(i);
+        }
+        if (progress[i].waiting == 0) {
+          ready.push_back(i);
+        }
+      }
+      remaining = ready.empty() ? 0 : nodes.size();
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::size_t> ready;
+    std::size_t remaining;  // nodes neither finished nor cancelled
+    bool stopped = false;
+    std::vector<Progress> progress;
+    Either<detail::InitDone, E> error;  // empty or the first error
+    std::size_t failed = kNone;
+    std::exception_ptr exception;
+    Clock::time_point start;
+  };
+
+  void Work(RunState& run) {
+    auto lock = std::unique_lock<std::mutex>(run.mutex);
+    while (true) {
+      run.wake.wait(lock, [&run] {
+        return !run.ready.empty() || run.remaining == 0 || run.stopped;
+      });
+      if (run.stopped || run.ready.empty()) {
+        return;
+      }
+      auto const node = run.ready.front();
+      run.ready.pop_front();
+      run.progress[node].started = Clock::now();
+      lock.unlock();
+
+      auto outcome = Either<detail::InitDone, E>();
+      auto exception = std::exception_ptr();
+      try {
+        outcome = nodes_[node].init();
+      } catch (...) {
+        exception = std::current_exception();
+      }
+
+      auto const finished = Clock::now();
+      lock.lock();
+      auto& progress = run.progress[node];
+      progress.finished = finished;
+      --run.remaining;
+      if (ET_LIKELY(!exception && outcome.IsSuccess())) {
+        progress.state = InitState::kSucceeded;
+        for (auto const dependent : progress.dependents) {
+          if (--run.progress[dependent].waiting == 0) {
+            run.progress[dependent].unblocked_by = node;
+            run.ready.push_back(dependent);
+          }
+        }
+      } else {
+        progress.state = InitState::kFailed;
+        if (!run.stopped) {
+          Stop(run, node, std::move(outcome), exception);
+        }
+      }
+      if (run.remaining == 0 || run.stopped || run.ready.size() > 1) {
+        run.wake.notify_all();
+      }
+    }
+  }
+
+  // the first failure: ready and waiting nodes are cancelled
+  static void Stop(RunState& run, std::size_t const node,
+                   Either<detail::InitDone, E>&& outcome,
+                   std::exception_ptr const& exception) {
+    run.stopped = true;
+    run.failed = node;
+    run.ready.clear();
+    if (exception) {
+      run.exception = exception;
+    } else {
+      run.error = std::move(outcome);
+    }
+  }
+
+  std::vector<Definition> nodes_;
+};
+
+template <class E>
+constexpr std::size_t InitGraph<E>::kNone;
+
+}  // namespace et
+
+#endif  // ET_INIT_GRAPH_HPP_
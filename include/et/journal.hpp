@@ -0,0 +1,499 @@
+#ifndef ET_JOURNAL_HPP_
+#define ET_JOURNAL_HPP_
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "et/either.hpp"
+#include "et/mapped_file.hpp"
+#include "et/sys.hpp"
+
+namespace et {
+
+// why opening a journal file failed
+class JournalError {
+ public:
+  enum class Kind {
+    kSystem,           // a syscall failed, see GetErrno()
+    kBadMagic,         // not a journal file
+    kVersionMismatch,  // written by another format version
+    kLayoutMismatch,   // entry size or capacity differ from the request
+    kTooSmall,         // file shorter than its header claims
+  };
+
+  explicit constexpr JournalError(Kind kind) noexcept
+      : kind_(kind), errno_(0) {}
+
+  explicit constexpr JournalError(Errno err) noexcept
+      : kind_(Kind::kSystem), errno_(err) {}
+
+  constexpr auto GetKind() const noexcept -> Kind { return kind_; }
+  constexpr auto GetErrno() const noexcept -> Errno { return errno_; }
+
+ private:
+  Kind kind_;
+  Errno errno_;
+};
+
+constexpr bool operator==(JournalError const lhs,
+                          JournalError const rhs) noexcept {
+  return lhs.GetKind() == rhs.GetKind() && lhs.GetErrno() == rhs.GetErrno();
+}
+
+constexpr bool operator!=(JournalError const lhs,
+                          JournalError const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, JournalError const err) {
+  using Kind = JournalError::Kind;
+  switch (err.GetKind()) {
+    case Kind::kSystem:
+      return os << err.GetErrno();
+    case Kind::kBadMagic:
+      return os << "not a journal file";
+    case Kind::kVersionMismatch:
+      return os << "journal format version mismatch";
+    case Kind::kLayoutMismatch:
+      return os << "journal layout mismatch";
+    case Kind::kTooSmall:
+      return os << "journal file too small";
+  }
+  return os;
+}
+
+// one decoded journal entry
+struct JournalRecord {
+  std::uint64_t sequence;
+  std::uint64_t time_ns;  // system_clock, nanoseconds since the epoch
+  std::uint64_t payload;
+  std::uint32_t site;
+  std::uint16_t thread;
+  bool error;
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                JournalRecord const& record) {
+  return os << record.time_ns << " thread " << record.thread << " site "
+            << record.site << (record.error ? " error " : " success ")
+            << record.payload;
+}
+
+namespace detail {
+
+// file layout: header, head counter on its own cache line, entries
+struct JournalHeader {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t entry_size;
+  std::uint64_t capacity;
+};
+
+// 0 in sequence marks an entry never written or mid write; a complete entry
+// holds its sequence number + 1, stored last
+struct JournalEntry {
+  std::atomic<std::uint64_t> sequence;
+  std::uint64_t time_ns;
+  std::uint64_t payload;
+  std::uint32_t site;
+  std::uint16_t thread;
+  std::uint8_t tag;
+  std::uint8_t reserved;
+};
+
+static_assert(std::is_standard_layout<JournalHeader>::value, "");
+static_assert(std::is_standard_layout<JournalEntry>::value, "");
+static_assert(sizeof(JournalEntry) == 32, "");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "[et::Journal] needs lock free 64 bit atomics");
+
+// "etJOURNL" read as a little endian word
+constexpr std::uint64_t kJournalMagic = 0x4C4E52554F4A7465ULL;
+constexpr std::uint32_t kJournalVersion = 1;
+constexpr std::size_t kJournalHeadOffset = 64;
+constexpr std::size_t kJournalEntriesOffset = 128;
+constexpr std::uint8_t kJournalSuccess = 1;
+constexpr std::uint8_t kJournalError = 2;
+
+inline auto JournalFileSize(std::uint64_t const capacity) noexcept
+    -> std::size_t {
+  return kJournalEntriesOffset +
+         static_cast<std::size_t>(capacity) * sizeof(JournalEntry);
+}
+
+inline auto CheckJournal(unsigned char const* base, std::size_t const size)
+    -> Either<std::uint64_t, JournalError> {
+  using Kind = JournalError::Kind;
+  if (size < kJournalEntriesOffset) {
+    return Error(JournalError(Kind::kTooSmall));
+  }
+  auto header = JournalHeader();
+  std::memcpy(&header, base, sizeof(header));
+  if (header.magic != kJournalMagic) {
+    return Error(JournalError(Kind::kBadMagic));
+  }
+  if (header.version != kJournalVersion) {
+    return Error(JournalError(Kind::kVersionMismatch));
+  }
+  if (header.entry_size != sizeof(JournalEntry) || header.capacity == 0 ||
+      (header.capacity & (header.capacity - 1)) != 0) {
+    return Error(JournalError(Kind::kLayoutMismatch));
+  }
+  if ((size - kJournalEntriesOffset) / sizeof(JournalEntry) <
+      header.capacity) {
+    return Error(JournalError(Kind::kTooSmall));
+  }
+  return Success(header.capacity);
+}
+
+// payloads travel as one word: integers and enums widened, other trivially
+// copyable types of up to 8 bytes copied bytewise
+template <class T>
+auto JournalWord(T const& value, std::true_type) noexcept -> std::uint64_t {
+  return static_cast<std::uint64_t>(value);
+}
+
+template <class T>
+auto JournalWord(T const& value, std::false_type) noexcept -> std::uint64_t {
+  static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= 8,
+                "[et::Journal] payloads must be trivially copyable and at "
+                "most 8 bytes");
+  auto word = std::uint64_t(0);
+  std::memcpy(&word, &value, sizeof(T));
+  return word;
+}
+
+template <class T>
+auto JournalWord(T const& value) noexcept -> std::uint64_t {
+  return JournalWord(
+      value, std::integral_constant<bool, std::is_integral<T>::value ||
+                                              std::is_enum<T>::value>());
+}
+
+}  // namespace detail
+
+// Append only ring of outcomes in a memory mapped file, for reading back
+// what a process did right before it died. Entries go to the page cache as
+// soon as they are written, so they survive a crash of the process (not of
+// the machine, see Flush). Each entry is 32 bytes: a call site id, success
+// or error, a one word payload, the thread and the wall clock time.
+//
+//   auto journal = et::Journal::Open("/var/tmp/worker.journal", 1 << 16);
+//   ...
+//   journal.Success().Append(kParseSite, ParseHeader(buf));
+//
+// Threads reserve kChunk entries at a time with one fetch_add on the shared
+// head and fill them without further synchronization; the ring keeps the
+// last Capacity() reserved entries. A thread alternating between journals
+// gives up the rest of its chunk on every switch.
+class Journal {
+ public:
+  static constexpr std::uint64_t kChunk = 16;
+
+  // opens path, creating it with capacity entries (rounded up to a power of
+  // two) if it does not exist or is empty; an existing journal must have
+  // that capacity. Concurrent openers of a new file take turns on an
+  // exclusive flock, so exactly one initializes it and the others see it
+  // complete.
+  static auto Open(char const* path, std::size_t const capacity) noexcept
+      -> Either<Journal, JournalError> {
+    auto entries = kChunk;
+    while (entries < capacity) {
+      entries <<= 1U;
+    }
+    auto const size = detail::JournalFileSize(entries);
+
+    auto const fd = sys::Open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (!fd) {
+      return Error(JournalError(fd.Error()));
+    }
+    // held until the fd is closed below, after the magic is written
+    auto locked = sys::Flock(fd.Success(), LOCK_EX);
+    while (!locked && locked.Error() == Errno(EINTR)) {
+      locked = sys::Flock(fd.Success(), LOCK_EX);
+    }
+    if (!locked) {
+      ::close(fd.Success());
+      return Error(JournalError(locked.Error()));
+    }
+    auto const st = sys::Fstat(fd.Success());
+    if (!st) {
+      ::close(fd.Success());
+      return Error(JournalError(st.Error()));
+    }
+    auto const fresh = st.Success().st_size == 0;
+    if (fresh) {
+      auto const resized =
+          sys::Ftruncate(fd.Success(), static_cast<::off_t>(size));
+      if (!resized) {
+        ::close(fd.Success());
+        return Error(JournalError(resized.Error()));
+      }
+    } else if (static_cast<std::size_t>(st.Success().st_size) != size) {
+      ::close(fd.Success());
+      return Error(JournalError(JournalError::Kind::kLayoutMismatch));
+    }
+
+    auto const addr = sys::Mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd.Success(), 0);
+    if (!addr) {
+      ::close(fd.Success());
+      return Error(JournalError(addr.Error()));
+    }
+
+    auto* const base = static_cast<unsigned char*>(addr.Success());
+    if (fresh) {
+      auto const header = detail::JournalHeader{
+          detail::kJournalMagic, detail::kJournalVersion,
+          static_cast<std::uint32_t>(sizeof(detail::JournalEntry)), entries};
+      ::new (base + detail::kJournalHeadOffset) std::atomic<std::uint64_t>(0);
+      for (auto i = std::uint64_t(0); i < entries; ++i) {
+        ::new (base + detail::kJournalEntriesOffset +
+               i * sizeof(detail::JournalEntry)) detail::JournalEntry();
+      }
+      // the magic goes last, a half created file does not pass as a journal
+      std::memcpy(base, &header, sizeof(header));
+    } else {
+      auto const checked = detail::CheckJournal(base, size);
+      if (!checked || checked.Success() != entries) {
+        ::munmap(base, size);
+        ::close(fd.Success());
+        return Error(checked ? JournalError(JournalError::Kind::kLayoutMismatch)
+                             : checked.Error());
+      }
+    }
+    // releases the lock, the next opener finds the journal complete
+    ::close(fd.Success());
+    return Success(Journal(base, size, entries));
+  }
+
+  Journal(Journal const&) = delete;
+  Journal& operator=(Journal const&) = delete;
+
+  Journal(Journal&& that) noexcept
+      : base_(std::exchange(that.base_, nullptr)),
+        size_(std::exchange(that.size_, 0)),
+        mask_(that.mask_),
+        id_(std::exchange(that.id_, 0)) {}
+
+  Journal& operator=(Journal&& that) noexcept {
+    if (this != &that) {
+      Unmap();
+      base_ = std::exchange(that.base_, nullptr);
+      size_ = std::exchange(that.size_, 0);
+      mask_ = that.mask_;
+      id_ = std::exchange(that.id_, 0);
+    }
+    return *this;
+  }
+
+  ~Journal() { Unmap(); }
+
+  auto Capacity() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(mask_ + 1);
+  }
+
+  void Append(std::uint32_t const site, bool const error,
+              std::uint64_t const payload) noexcept {
+    auto& cursor = Cursor();
+    // a chunk the ring has lapped would overwrite newer entries
+    if (ET_UNLIKELY(cursor.journal != id_ || cursor.next == cursor.end ||
+                    cursor.next + mask_ <
+                        Head().load(std::memory_order_relaxed))) {
+      cursor.journal = id_;
+      cursor.next = Head().fetch_add(kChunk, std::memory_order_relaxed);
+      cursor.end = cursor.next + kChunk;
+    }
+    auto const sequence = cursor.next++;
+
+    auto& entry = EntryAt(sequence);
+    entry.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.time_ns = Now();
+    entry.payload = payload;
+    entry.site = site;
+    entry.thread = Thread();
+    entry.tag = error ? detail::kJournalError : detail::kJournalSuccess;
+    entry.sequence.store(sequence + 1, std::memory_order_release);
+  }
+
+  template <class S, class E>
+  void Append(std::uint32_t const site, Either<S, E> const& outcome) noexcept {
+    if (outcome.IsSuccess()) {
+      Append(site, false, detail::JournalWord(outcome.Success()));
+    } else if (outcome.IsError()) {
+      Append(site, true, detail::JournalWord(outcome.Error()));
+    }
+  }
+
+  template <class S>
+  void Append(std::uint32_t const site,
+              Either<S, void> const& outcome) noexcept {
+    Append(site, false, detail::JournalWord(outcome.Success()));
+  }
+
+  template <class E>
+  void Append(std::uint32_t const site,
+              Either<void, E> const& outcome) noexcept {
+    Append(site, true, detail::JournalWord(outcome.Error()));
+  }
+
+  // writes the mapping back to the file, for surviving a machine crash too
+  auto Flush() const noexcept -> Either<int, Errno> {
+    return sys::Msync(base_, size_, MS_SYNC);
+  }
+
+ private:
+  struct ThreadCursor {
+    std::uint64_t journal;
+    std::uint64_t next;
+    std::uint64_t end;
+  };
+
+  Journal(unsigned char* base, std::size_t size, std::uint64_t entries) noexcept
+      : base_(base), size_(size), mask_(entries - 1), id_(NextId()) {}
+
+  static auto NextId() noexcept -> std::uint64_t {
+    static std::atomic<std::uint64_t> next(1);
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // trivial thread_locals, no guard check on the fast path
+  static auto Cursor() noexcept -> ThreadCursor& {
+    static thread_local ThreadCursor cursor = {0, 0, 0};
+    return cursor;
+  }
+
+  static auto Thread() noexcept -> std::uint16_t {
+    static std::atomic<std::uint32_t> next(0);
+    static thread_local std::uint16_t thread = 0;
+    if (ET_UNLIKELY(thread == 0)) {
+      thread = static_cast<std::uint16_t>(
+          next.fetch_add(1, std::memory_order_relaxed) % 0xFFFFU + 1);
+    }
+    return thread;
+  }
+
+  static auto Now() noexcept -> std::uint64_t {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+  }
+
+  auto Head() const noexcept -> std::atomic<std::uint64_t>& {
+    return *reinterpret_cast<std::atomic<std::uint64_t>*>(
+        base_ + detail::kJournalHeadOffset);
+  }
+
+  auto EntryAt(std::uint64_t const sequence) const noexcept
+      -> detail::JournalEntry& {
+    return reinterpret_cast<detail::JournalEntry*>(
+        base_ + detail::kJournalEntriesOffset)[sequence & mask_];
+  }
+
+  void Unmap() noexcept {
+    if (base_ != nullptr) {
+      ::munmap(base_, size_);
+      base_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  unsigned char* base_ = nullptr;
+  std::size_t size_ = 0;
+  std::uint64_t mask_ = 0;
+  std::uint64_t id_ = 0;
+};
+
+// decodes a journal file, also one a live or crashed process still maps
+class JournalReader {
+ public:
+  static auto Open(char const* path) noexcept
+      -> Either<JournalReader, JournalError> {
+    auto file = MappedFile::Open(path);
+    if (!file) {
+      return Error(JournalError(file.Error()));
+    }
+    auto const checked = detail::CheckJournal(
+        reinterpret_cast<unsigned char const*>(file.Success().Data()),
+        file.Success().Size());
+    if (!checked) {
+      return Error(checked.Error());
+    }
+    return Success(JournalReader(std::move(file).Success(), checked.Success()));
+  }
+
+  auto Capacity() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(capacity_);
+  }
+
+  // entries reserved so far, including those overwritten since
+  auto Appended() const noexcept -> std::uint64_t {
+    return Head().load(std::memory_order_acquire);
+  }
+
+  // complete entries still in the ring, oldest first; entries reserved but
+  // never written (chunks of exited threads, writes cut by a crash) are
+  // skipped
+  auto Records() const -> std::vector<JournalRecord> {
+    auto const head = Appended();
+    auto const oldest = head > capacity_ ? head - capacity_ : 0;
+    auto records = std::vector<JournalRecord>();
+    records.reserve(static_cast<std::size_t>(std::min(head, capacity_)));
+
+    auto const* const entries = reinterpret_cast<detail::JournalEntry const*>(
+        file_.Data() + detail::kJournalEntriesOffset);
+    for (auto i = std::uint64_t(0); i < capacity_; ++i) {
+      auto const& entry = entries[i];
+      auto const stamp = entry.sequence.load(std::memory_order_acquire);
+      if (stamp == 0 || stamp - 1 < oldest) {
+        continue;
+      }
+      auto const record = JournalRecord{
+          stamp - 1,  entry.time_ns, entry.payload,
+          entry.site, entry.thread,  entry.tag == detail::kJournalError};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (entry.sequence.load(std::memory_order_relaxed) == stamp) {
+        records.push_back(record);
+      }
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](JournalRecord const& lhs, JournalRecord const& rhs) {
+                return lhs.time_ns != rhs.time_ns ? lhs.time_ns < rhs.time_ns
+                                                  : lhs.sequence < rhs.sequence;
+              });
+    return records;
+  }
+
+ private:
+  JournalReader(MappedFile file, std::uint64_t capacity) noexcept
+      : file_(std::move(file)), capacity_(capacity) {}
+
+  auto Head() const noexcept -> std::atomic<std::uint64_t> const& {
+    return *reinterpret_cast<std::atomic<std::uint64_t> const*>(
+        file_.Data() + detail::kJournalHeadOffset);
+  }
+
+  MappedFile file_;
+  std::uint64_t capacity_;
+};
+
+}  // namespace et
+
+#endif  // ET_JOURNAL_HPP_
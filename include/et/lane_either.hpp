@@ -0,0 +1,281 @@
+#ifndef ET_LANE_EITHER_HPP_
+#define ET_LANE_EITHER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// Lane type and count of a vector of values. The default covers
+// std::array<S, N> and compiler vector types (GCC/Clang vector_size,
+// Clang ext_vector_type): anything indexable whose size is N elements.
+// Specialize it for wrapper types like xsimd::batch.
+template <class VecS, class = void>
+struct LaneTraits {
+  using ElementType = std::decay_t<decltype(std::declval<VecS&>()[0])>;
+  static constexpr std::size_t kLanes = sizeof(VecS) / sizeof(ElementType);
+};
+
+namespace detail {
+
+inline auto PopCount(std::uint64_t const value) noexcept -> std::size_t {
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_popcountll(value));
+#else
+  auto count = std::size_t(0);
+  for (auto v = value; v != 0; v &= v - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+template <class F, class VecS>
+using LaneResultType =
+    std::decay_t<decltype(std::declval<F&>()(std::declval<VecS const&>()))>;
+
+}  // namespace detail
+
+// N results of a vectorized kernel: the values as one SIMD vector, a bitmask
+// with bit i set when lane i succeeded and the errors of the failed lanes,
+// stored compactly in lane order. An all success LaneEither never allocates;
+// the values of failed lanes are unspecified.
+//
+//   using Lanes = et::LaneEither<Floats8, std::uint8_t, MathError>;
+//   auto const divisors = Lanes(d).Fail(Zeros(d), MathError::kDivByZero);
+//   auto const quotients = divisors.Map([&](Floats8 v) { return n / v; });
+//   Store(out, quotients.Select(fallback));
+template <class VecS, class MaskT, class E>
+class LaneEither {
+ public:
+  using VectorType = VecS;
+  using MaskType = MaskT;
+  using SuccessType = typename LaneTraits<VecS>::ElementType;
+  using ErrorType = E;
+  using LaneType = Either<SuccessType, ErrorType>;
+
+  static constexpr std::size_t kLanes = LaneTraits<VecS>::kLanes;
+
+  static_assert(std::is_unsigned<MaskT>::value &&
+                    !std::is_same<MaskT, bool>::value,
+                "[et::LaneEither] mask must be an unsigned integer");
+  static_assert(kLanes > 0 &&
+                    kLanes <= static_cast<std::size_t>(
+                                  std::numeric_limits<MaskT>::digits) &&
+                    kLanes <= 64,
+                "[et::LaneEither] mask has fewer bits than lanes");
+  static_assert(!std::is_reference<E>::value && !std::is_void<E>::value,
+                "[et::LaneEither] error must be an object type");
+
+  static constexpr MaskT kAllLanes = static_cast<MaskT>(
+      kLanes == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << kLanes) - 1);
+
+  // every lane succeeds
+  explicit LaneEither(VecS const& values) noexcept(
+      std::is_nothrow_copy_constructible<VecS>::value)
+      : values_(values), mask_(kAllLanes) {}
+
+  // lanes outside success fail with a copy of error each
+  LaneEither(VecS const& values, MaskT const success, E const& error)
+      : LaneEither(values) {
+    Fail(static_cast<MaskT>(~success), error);
+  }
+
+  explicit LaneEither(std::array<LaneType, kLanes> const& lanes)
+      : values_(), mask_(0) {
+    for (auto lane = std::size_t(0); lane < kLanes; ++lane) {
+      if (lanes[lane].IsSuccess()) {
+        values_[lane] = lanes[lane].Success();
+        mask_ = static_cast<MaskT>(mask_ | Bit(lane));
+      } else {
+        errors_.push_back(lanes[lane].Error());
+      }
+    }
+  }
+
+  // values of all lanes, those of failed lanes are unspecified
+  auto Values() const noexcept -> VecS const& { return values_; }
+
+  auto SuccessMask() const noexcept -> MaskT { return mask_; }
+
+  auto ErrorMask() const noexcept -> MaskT {
+    return static_cast<MaskT>(~mask_ & kAllLanes);
+  }
+
+  auto AllSuccess() const noexcept -> bool { return mask_ == kAllLanes; }
+
+  auto IsSuccess(std::size_t const lane) const noexcept -> bool {
+    return lane < kLanes && (mask_ & Bit(lane)) != 0;
+  }
+
+  auto IsError(std::size_t const lane) const noexcept -> bool {
+    return lane < kLanes && (mask_ & Bit(lane)) == 0;
+  }
+
+  auto Success(std::size_t const lane) const -> SuccessType {
+    if (!IsSuccess(lane)) {
+      throw BadEitherAccess("[et::LaneEither::Success] invalid state access");
+    }
+    return values_[lane];
+  }
+
+  auto Error(std::size_t const lane) const -> ErrorType const& {
+    if (!IsError(lane)) {
+      throw BadEitherAccess("[et::LaneEither::Error] invalid state access");
+    }
+    return errors_[ErrorIndex(lane)];
+  }
+
+  auto Lane(std::size_t const lane) const -> LaneType {
+    if (IsSuccess(lane)) {
+      return LaneType(et::Success(values_[lane]));
+    }
+    return LaneType(et::Error(Error(lane)));
+  }
+
+  auto ToArray() const -> std::array<LaneType, kLanes> {
+    return ToArray(std::make_index_sequence<kLanes>());
+  }
+
+  // fails the lanes in lanes that still succeed, failed lanes keep their
+  // first error
+  auto Fail(MaskT const lanes, E const& error) -> LaneEither& {
+    auto const failing = static_cast<std::uint64_t>(lanes & mask_);
+    for (auto lane = std::size_t(0); lane < kLanes; ++lane) {
+      if ((failing >> lane) & 1U) {
+        errors_.insert(errors_.begin() + ErrorIndex(lane), error);
+        mask_ = static_cast<MaskT>(mask_ & ~Bit(lane));
+      }
+    }
+    return *this;
+  }
+
+  // applies f(VecS) -> VecR to all lanes at once; failed lanes keep their
+  // error and get unspecified values
+  template <class F, class VecR = detail::LaneResultType<F, VecS>>
+  auto Map(F&& f) const& -> LaneEither<VecR, MaskT, E> {
+    return LaneEither<VecR, MaskT, E>(f(values_), mask_, errors_);
+  }
+
+  template <class F, class VecR = detail::LaneResultType<F, VecS>>
+  auto Map(F&& f) && -> LaneEither<VecR, MaskT, E> {
+    return LaneEither<VecR, MaskT, E>(f(values_), mask_, std::move(errors_));
+  }
+
+  // applies f(VecS) -> LaneEither<VecR, MaskT, E>, a lane succeeds when it
+  // succeeded here and in the result; f is skipped when no lane succeeds
+  template <class F, class R = detail::LaneResultType<F, VecS>>
+  auto AndThen(F&& f) const& -> R {
+    return AndThenImpl(f, errors_);
+  }
+
+  template <class F, class R = detail::LaneResultType<F, VecS>>
+  auto AndThen(F&& f) && -> R {
+    return AndThenImpl(f, std::move(errors_));
+  }
+
+  // masked blend: the value of succeeded lanes, fallback of failed ones
+  auto Select(VecS const& fallback) const -> VecS {
+    auto result = fallback;
+    for (auto lane = std::size_t(0); lane < kLanes; ++lane) {
+      result[lane] = (mask_ & Bit(lane)) != 0 ? values_[lane] : fallback[lane];
+    }
+    return result;
+  }
+
+  auto ValueOr(SuccessType const& fallback) const -> VecS {
+    auto result = values_;
+    for (auto lane = std::size_t(0); lane < kLanes; ++lane) {
+      result[lane] = (mask_ & Bit(lane)) != 0 ? values_[lane] : fallback;
+    }
+    return result;
+  }
+
+ private:
+  template <class, class, class>
+  friend class LaneEither;
+
+  LaneEither(VecS const& values, MaskT const mask, std::vector<E> errors)
+      : values_(values), mask_(mask), errors_(std::move(errors)) {}
+
+  static constexpr auto Bit(std::size_t const lane) noexcept -> MaskT {
+    return static_cast<MaskT>(std::uint64_t(1) << lane);
+  }
+
+  // position of the error of lane among the failed lanes
+  auto ErrorIndex(std::size_t const lane) const noexcept -> std::ptrdiff_t {
+    auto const below = (std::uint64_t(1) << lane) - 1;
+    return static_cast<std::ptrdiff_t>(
+        detail::PopCount(static_cast<std::uint64_t>(ErrorMask()) & below));
+  }
+
+  template <std::size_t... Lanes>
+  auto ToArray(std::index_sequence<Lanes...>) const
+      -> std::array<LaneType, kLanes> {
+    return {{Lane(Lanes)...}};
+  }
+
+  template <class F, class Errors>
+  auto AndThenImpl(F& f, Errors&& errors) const
+      -> detail::LaneResultType<F, VecS> {
+    using R = detail::LaneResultType<F, VecS>;
+    static_assert(std::is_same<typename R::MaskType, MaskT>::value &&
+                      std::is_same<typename R::ErrorType, E>::value,
+                  "[et::LaneEither::AndThen] f must return a LaneEither with "
+                  "the same mask and error types");
+    static_assert(R::kLanes == kLanes,
+                  "[et::LaneEither::AndThen] lane count mismatch");
+
+    if (mask_ == 0) {
+      return R(typename R::VectorType(), MaskT(0),
+               std::forward<Errors>(errors));
+    }
+    auto next = f(values_);
+    if (mask_ == kAllLanes) {
+      return next;
+    }
+    if (next.mask_ == kAllLanes) {
+      return R(next.values_, mask_, std::forward<Errors>(errors));
+    }
+
+    auto merged = std::vector<E>();
+    merged.reserve(kLanes - detail::PopCount(mask_ & next.mask_));
+    auto mine = errors.begin();
+    auto theirs = next.errors_.begin();
+    for (auto lane = std::size_t(0); lane < kLanes; ++lane) {
+      auto const failed_here = (mask_ & Bit(lane)) == 0;
+      auto const failed_there = (next.mask_ & Bit(lane)) == 0;
+      if (failed_here) {
+        merged.push_back(std::move(*mine));
+        ++mine;
+        theirs += failed_there ? 1 : 0;
+      } else if (failed_there) {
+        merged.push_back(std::move(*theirs));
+        ++theirs;
+      }
+    }
+    return R(next.values_, static_cast<MaskT>(mask_ & next.mask_),
+             std::move(merged));
+  }
+
+  VecS values_;
+  MaskT mask_;
+  std::vector<E> errors_;
+};
+
+template <class VecS, class MaskT, class E>
+constexpr MaskT LaneEither<VecS, MaskT, E>::kAllLanes;
+
+template <class VecS, class MaskT, class E>
+constexpr std::size_t LaneEither<VecS, MaskT, E>::kLanes;
+
+}  // namespace et
+
+#endif  // ET_LANE_EITHER_HPP_
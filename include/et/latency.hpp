@@ -0,0 +1,365 @@
+#ifndef ET_LATENCY_HPP_
+#define ET_LATENCY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define ET_HAS_RDTSC 1
+#else
+#define ET_HAS_RDTSC 0
+#endif
+
+#include "et/either.hpp"
+
+namespace et {
+
+namespace detail {
+
+// raw time stamp counter where available, steady clock nanoseconds otherwise;
+// not serializing, which is fine for calls taking tens of cycles or more
+inline auto ReadTicks() noexcept -> std::uint64_t {
+#if ET_HAS_RDTSC
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+// measured once against the steady clock over a few milliseconds
+inline auto NanosecondsPerTick() -> double {
+#if ET_HAS_RDTSC
+  static auto const ns_per_tick = [] {
+    using Clock = std::chrono::steady_clock;
+    auto const start = Clock::now();
+    auto const start_ticks = ReadTicks();
+    auto now = start;
+    while (now - start < std::chrono::milliseconds(10)) {
+      now = Clock::now();
+    }
+    auto const ticks = ReadTicks() - start_ticks;
+    auto const ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - start);
+    return ticks == 0 ? 1.0
+                      : static_cast<double>(ns.count()) /
+                            static_cast<double>(ticks);
+  }();
+  return ns_per_tick;
+#else
+  return 1.0;
+#endif
+}
+
+inline auto HighestBit(std::uint64_t const value) noexcept -> unsigned {
+#if defined(__GNUC__)
+  return 63U - static_cast<unsigned>(__builtin_clzll(value));
+#else
+  auto bit = 0U;
+  for (auto v = value; v >>= 1U;) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+// hands every live thread a distinct slot below kMaxThreads; slots of exited
+// threads are reused, threads beyond the limit share the overflow slot
+class LatencyThreadSlot {
+ public:
+  static constexpr auto kMaxThreads = std::size_t(256);
+  static constexpr auto kOverflow = kMaxThreads;
+
+  // a trivially destructible thread_local avoids the guard check on the
+  // fast path
+  static auto Current() -> std::size_t {
+    static thread_local auto slot = kUnassigned;
+    if (ET_UNLIKELY(slot == kUnassigned)) {
+      slot = Acquire();
+    }
+    return slot;
+  }
+
+ private:
+  static constexpr auto kUnassigned = ~std::size_t(0);
+
+  static auto Acquire() -> std::size_t {
+    static thread_local Lease const lease;
+    return lease.slot;
+  }
+
+  struct Registry {
+    // releasing a slot never allocates
+    Registry() { free.reserve(kMaxThreads); }
+
+    std::mutex mutex;
+    std::vector<std::size_t> free;
+    std::size_t next = 0;
+  };
+
+  // never destroyed, threads may exit during static destruction
+  static auto GetRegistry() -> Registry& {
+    static auto* const registry = new Registry();
+    return *registry;
+  }
+
+  struct Lease {
+    Lease() {
+      auto& registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      if (!registry.free.empty()) {
+        slot = registry.free.back();
+        registry.free.pop_back();
+      } else if (registry.next < kMaxThreads) {
+        slot = registry.next++;
+      }
+    }
+
+    Lease(Lease const&) = delete;
+    Lease& operator=(Lease const&) = delete;
+
+    ~Lease() {
+      if (slot != kOverflow) {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.free.push_back(slot);
+      }
+    }
+
+    std::size_t slot = kOverflow;
+  };
+};
+
+}  // namespace detail
+
+// Log bucketed histogram in the HDR style: values below kSubBuckets get a
+// bucket each, above that every power of two is split into kSubBuckets
+// linear buckets, bounding the relative error to 1 / kSubBuckets.
+class LatencyHistogram {
+ public:
+  static constexpr auto kSubBucketBits = 4U;
+  static constexpr auto kSubBuckets = std::size_t(1) << kSubBucketBits;
+  static constexpr auto kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  static auto BucketOf(std::uint64_t const value) noexcept -> std::size_t {
+    if (value < kSubBuckets) {
+      return static_cast<std::size_t>(value);
+    }
+    auto const bit = detail::HighestBit(value);
+    auto const shift = bit - kSubBucketBits;
+    return (shift + 1) * kSubBuckets +
+           static_cast<std::size_t>((value >> shift) & (kSubBuckets - 1));
+  }
+
+  // smallest value falling into bucket
+  static auto LowerBound(std::size_t const bucket) noexcept -> std::uint64_t {
+    if (bucket < kSubBuckets) {
+      return bucket;
+    }
+    auto const group = bucket / kSubBuckets;
+    auto const sub = bucket % kSubBuckets;
+    return static_cast<std::uint64_t>(kSubBuckets + sub) << (group - 1);
+  }
+
+  // largest value falling into bucket
+  static auto UpperBound(std::size_t const bucket) noexcept -> std::uint64_t {
+    return bucket + 1 == kBuckets ? ~std::uint64_t(0)
+                                  : LowerBound(bucket + 1) - 1;
+  }
+
+  void Record(std::uint64_t const value, std::uint64_t const count = 1) {
+    counts_[BucketOf(value)] += count;
+    count_ += count;
+    sum_ += value * count;
+  }
+
+  void Merge(LatencyHistogram const& that) noexcept {
+    for (auto i = std::size_t(0); i < kBuckets; ++i) {
+      counts_[i] += that.counts_[i];
+    }
+    count_ += that.count_;
+    sum_ += that.sum_;
+  }
+
+  auto Count() const noexcept -> std::uint64_t { return count_; }
+  auto Sum() const noexcept -> std::uint64_t { return sum_; }
+
+  auto CountAt(std::size_t const bucket) const -> std::uint64_t {
+    return counts_.at(bucket);
+  }
+
+  auto Mean() const noexcept -> double {
+    return count_ == 0
+               ? 0.0
+               : static_cast<double>(sum_) / static_cast<double>(count_);
+  }
+
+  // upper bound of the bucket holding the value at quantile q in [0, 1]
+  auto Percentile(double const q) const noexcept -> std::uint64_t {
+    if (count_ == 0) {
+      return 0;
+    }
+    auto const clamped = q < 0.0 ? 0.0 : q > 1.0 ? 1.0 : q;
+    auto const rank = std::max<std::uint64_t>(
+        static_cast<std::uint64_t>(
+            std::ceil(clamped * static_cast<double>(count_))),
+        1);
+    auto seen = std::uint64_t(0);
+    for (auto i = std::size_t(0); i < kBuckets; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return UpperBound(i);
+      }
+    }
+    return UpperBound(kBuckets - 1);
+  }
+
+ private:
+  friend class LatencyRecorder;
+
+  std::array<std::uint64_t, kBuckets> counts_{};
+  std::uint64_t count_ = 0;
+  std::uint64_t sum_ = 0;
+};
+
+// merged view of a LatencyRecorder; histograms count raw ticks
+struct LatencyReport {
+  LatencyHistogram success;
+  LatencyHistogram error;
+  double ns_per_tick;
+
+  auto Nanoseconds(std::uint64_t const ticks) const noexcept -> double {
+    return static_cast<double>(ticks) * ns_per_tick;
+  }
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                LatencyReport const& report) {
+  auto const print = [&](char const* outcome, LatencyHistogram const& h) {
+    os << outcome << ": count " << h.Count() << " mean "
+       << h.Mean() * report.ns_per_tick << "ns p50 "
+       << report.Nanoseconds(h.Percentile(0.5)) << "ns p99 "
+       << report.Nanoseconds(h.Percentile(0.99)) << "ns p999 "
+       << report.Nanoseconds(h.Percentile(0.999)) << "ns";
+  };
+  print("success", report.success);
+  os << ", ";
+  print("error", report.error);
+  return os;
+}
+
+// Times Either returning calls into per thread histograms split by outcome.
+// Each thread only ever writes its own shard with plain relaxed stores, so
+// recording takes no lock and no read-modify-write; Snapshot() sums all
+// shards with relaxed loads while they are being written. Calls leaving
+// through an exception are not recorded.
+class LatencyRecorder {
+ public:
+  LatencyRecorder() = default;
+
+  LatencyRecorder(LatencyRecorder const&) = delete;
+  LatencyRecorder& operator=(LatencyRecorder const&) = delete;
+
+  ~LatencyRecorder() {
+    for (auto& shard : shards_) {
+      delete shard.load(std::memory_order_relaxed);
+    }
+  }
+
+  template <class F>
+  auto Time(F&& f) -> decltype(std::forward<F>(f)()) {
+    auto const start = detail::ReadTicks();
+    auto result = std::forward<F>(f)();
+    Record(result.IsSuccess(), detail::ReadTicks() - start);
+    return result;
+  }
+
+  void Record(bool const success, std::uint64_t const ticks) {
+    auto const slot = detail::LatencyThreadSlot::Current();
+    auto& shard = ShardAt(slot);
+    auto& counters = success ? shard.success : shard.error;
+    auto& bucket = counters.buckets[LatencyHistogram::BucketOf(ticks)];
+    if (ET_LIKELY(slot != detail::LatencyThreadSlot::kOverflow)) {
+      bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+      counters.sum.store(counters.sum.load(std::memory_order_relaxed) + ticks,
+                         std::memory_order_relaxed);
+    } else {
+      bucket.fetch_add(1, std::memory_order_relaxed);
+      counters.sum.fetch_add(ticks, std::memory_order_relaxed);
+    }
+  }
+
+  auto Snapshot() const -> LatencyReport {
+    auto report = LatencyReport{LatencyHistogram(), LatencyHistogram(),
+                                detail::NanosecondsPerTick()};
+    for (auto const& slot : shards_) {
+      auto const* const shard = slot.load(std::memory_order_acquire);
+      if (shard != nullptr) {
+        Accumulate(shard->success, report.success);
+        Accumulate(shard->error, report.error);
+      }
+    }
+    return report;
+  }
+
+ private:
+  struct Counters {
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBuckets>
+        buckets{};
+    std::atomic<std::uint64_t> sum{0};
+  };
+
+  struct Shard {
+    Counters success;
+    Counters error;
+  };
+
+  static void Accumulate(Counters const& counters,
+                         LatencyHistogram& histogram) {
+    for (auto i = std::size_t(0); i < LatencyHistogram::kBuckets; ++i) {
+      auto const count = counters.buckets[i].load(std::memory_order_relaxed);
+      histogram.counts_[i] += count;
+      histogram.count_ += count;
+    }
+    histogram.sum_ += counters.sum.load(std::memory_order_relaxed);
+  }
+
+  auto ShardAt(std::size_t const slot) -> Shard& {
+    auto* shard = shards_[slot].load(std::memory_order_acquire);
+    if (ET_UNLIKELY(shard == nullptr)) {
+      auto* const fresh = new Shard();
+      if (shards_[slot].compare_exchange_strong(shard, fresh,
+                                                std::memory_order_acq_rel)) {
+        shard = fresh;
+      } else {
+        delete fresh;
+      }
+    }
+    return *shard;
+  }
+
+  std::array<std::atomic<Shard*>, detail::LatencyThreadSlot::kMaxThreads + 1>
+      shards_{};
+};
+
+}  // namespace et
+
+// times expr, an Either valued expression, into recorder:
+//   static et::LatencyRecorder recorder;
+//   auto const fd = ET_TIMED(recorder, et::sys::Open(path, O_RDONLY));
+#define ET_TIMED(recorder, expr) ((recorder).Time([&]() { return expr; }))
+
+#endif  // ET_LATENCY_HPP_
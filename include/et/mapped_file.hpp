@@ -0,0 +1,154 @@
+#ifndef ET_MAPPED_FILE_HPP_
+#define ET_MAPPED_FILE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "et/either.hpp"
+#include "et/sys.hpp"
+
+namespace et {
+
+// read only, private mapping of a whole file; unmapped on destruction
+class MappedFile {
+ public:
+  enum class Advice { kNormal, kSequential, kRandom, kWillNeed, kHugePage };
+
+  static auto Open(char const* path) noexcept -> Either<MappedFile, Errno> {
+    auto const fd = sys::Open(path, O_RDONLY | O_CLOEXEC);
+    if (!fd) {
+      return Error(fd.Error());
+    }
+
+    auto const st = sys::Fstat(fd.Success());
+    if (!st) {
+      ::close(fd.Success());
+      return Error(st.Error());
+    }
+
+    // mmap rejects zero length mappings, an empty file maps to nothing
+    auto const size = static_cast<std::size_t>(st.Success().st_size);
+    if (size == 0) {
+      ::close(fd.Success());
+      return Success(MappedFile());
+    }
+
+    auto const addr =
+        sys::Mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd.Success(), 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd.Success());
+    if (!addr) {
+      return Error(addr.Error());
+    }
+
+    return Success(MappedFile(static_cast<char const*>(addr.Success()), size));
+  }
+
+  static auto Open(std::string const& path) noexcept
+      -> Either<MappedFile, Errno> {
+    return Open(path.c_str());
+  }
+
+  MappedFile() noexcept = default;
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  MappedFile(MappedFile&& that) noexcept
+      : data_(std::exchange(that.data_, nullptr)),
+        size_(std::exchange(that.size_, 0)) {}
+
+  MappedFile& operator=(MappedFile&& that) noexcept {
+    if (this != &that) {
+      Unmap();
+      data_ = std::exchange(that.data_, nullptr);
+      size_ = std::exchange(that.size_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedFile() { Unmap(); }
+
+  // hints for the whole mapping or a page aligned [offset, offset + length)
+  auto Advise(Advice advice) const noexcept -> Either<int, Errno> {
+    return Advise(advice, 0, size_);
+  }
+
+  auto Advise(Advice advice, std::size_t offset,
+              std::size_t length) const noexcept -> Either<int, Errno> {
+    if (data_ == nullptr) {
+      return Success(0);
+    }
+    return sys::Madvise(const_cast<char*>(data_) + offset, length,
+                        ToNative(advice));
+  }
+
+  constexpr auto Data() const noexcept -> char const* { return data_; }
+  constexpr auto Size() const noexcept -> std::size_t { return size_; }
+  constexpr auto Empty() const noexcept -> bool { return size_ == 0; }
+
+  constexpr auto begin() const noexcept -> char const* { return data_; }
+  constexpr auto end() const noexcept -> char const* { return data_ + size_; }
+
+#if __cplusplus >= 201703L
+  constexpr auto View() const noexcept -> std::string_view {
+    return std::string_view(data_, size_);
+  }
+#endif
+
+#if __cplusplus >= 202002L
+  auto Bytes() const noexcept -> std::span<std::byte const> {
+    return std::as_bytes(std::span<char const>(data_, size_));
+  }
+#endif
+
+ private:
+  MappedFile(char const* data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  static auto ToNative(Advice advice) noexcept -> int {
+    switch (advice) {
+      case Advice::kSequential:
+        return MADV_SEQUENTIAL;
+      case Advice::kRandom:
+        return MADV_RANDOM;
+      case Advice::kWillNeed:
+        return MADV_WILLNEED;
+      case Advice::kHugePage:
+#ifdef MADV_HUGEPAGE
+        return MADV_HUGEPAGE;
+#else
+        return MADV_NORMAL;
+#endif
+      case Advice::kNormal:
+        break;
+    }
+    return MADV_NORMAL;
+  }
+
+  void Unmap() noexcept {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  char const* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace et
+
+#endif  // ET_MAPPED_FILE_HPP_
@@ -0,0 +1,328 @@
+#ifndef ET_MEMO_CACHE_HPP_
+#define ET_MEMO_CACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// Memoizes an Either returning function. Successes and errors are cached
+// with separate time to live (a zero ttl disables caching that outcome),
+// concurrent misses on one key share a single computation and every shard
+// holds a bounded number of entries evicted in CLOCK order.
+template <class K, class S, class E, class Hash = std::hash<K>,
+          class KeyEqual = std::equal_to<K>>
+class MemoCache {
+ public:
+  using KeyType = K;
+  using ValueType = Either<S, E>;
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    std::size_t capacity = 1024;
+    std::size_t shards = 16;
+    Clock::duration success_ttl = std::chrono::minutes(5);
+    Clock::duration error_ttl = std::chrono::seconds(5);
+  };
+
+  struct Stats {
+    std::uint64_t hits;
+    std::uint64_t negative_hits;  // hits that returned a cached error
+    std::uint64_t misses;
+    std::uint64_t coalesced;  // misses that waited on another computation
+    std::uint64_t evictions;
+    std::uint64_t expirations;
+  };
+
+  explicit MemoCache(Options const& options = Options(),
+                     Hash const& hash = Hash(),
+                     KeyEqual const& key_equal = KeyEqual())
+      : success_ttl_(options.success_ttl),
+        error_ttl_(options.error_ttl),
+        hash_(hash),
+        shards_(std::max<std::size_t>(options.shards, 1)) {
+    auto const per_shard =
+        std::max<std::size_t>((options.capacity + shards_.size() - 1) /
+                                  shards_.size(),
+                              1);
+    for (auto& shard : shards_) {
+      shard = std::make_unique<Shard>(per_shard, hash, key_equal);
+    }
+  }
+
+  MemoCache(MemoCache const&) = delete;
+  MemoCache& operator=(MemoCache const&) = delete;
+
+  // returns the cached result for key or computes it through compute(key)
+  template <class F>
+  auto Get(KeyType const& key, F&& compute) -> ValueType {
+    auto const hash = hash_(key);
+    auto& shard = ShardFor(hash);
+    auto const now = Clock::now();
+
+    {
+      std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+      auto const it = shard.index.find(key);
+      if (it != shard.index.end()) {
+        auto& slot = shard.slots[it->second];
+        if (slot.entry->expires > now) {
+          slot.referenced.store(true, std::memory_order_relaxed);
+          CountHit(shard, slot.entry->value);
+          return slot.entry->value;
+        }
+      }
+    }
+
+    auto flight = std::shared_ptr<Flight>();
+    auto leader = false;
+    {
+      std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+      auto const it = shard.index.find(key);
+      if (it != shard.index.end()) {
+        auto& slot = shard.slots[it->second];
+        if (slot.entry->expires > Clock::now()) {
+          slot.referenced.store(true, std::memory_order_relaxed);
+          CountHit(shard, slot.entry->value);
+          return slot.entry->value;
+        }
+        shard.Release(it->second);
+        shard.expirations.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      auto& pending = shard.flights[key];
+      if (pending) {
+        flight = pending;
+        shard.coalesced.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        pending = flight = std::make_shared<Flight>();
+        leader = true;
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    if (!leader) {
+      return flight->Await();
+    }
+
+    try {
+      auto result = ValueType(std::forward<F>(compute)(key));
+      Publish(shard, key, result, *flight);
+      return result;
+    } catch (...) {
+      {
+        std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+        shard.flights.erase(key);
+      }
+      flight->Fail(std::current_exception());
+      throw;
+    }
+  }
+
+  auto Erase(KeyType const& key) -> bool {
+    auto& shard = ShardFor(hash_(key));
+    std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+    auto const it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      return false;
+    }
+    shard.Release(it->second);
+    return true;
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::shared_timed_mutex> lock(shard->mutex);
+      for (auto i = std::size_t(0); i < shard->slots.size(); ++i) {
+        if (shard->slots[i].entry) {
+          shard->Release(i);
+        }
+      }
+    }
+  }
+
+  auto Size() const -> std::size_t {
+    auto size = std::size_t(0);
+    for (auto const& shard : shards_) {
+      std::shared_lock<std::shared_timed_mutex> lock(shard->mutex);
+      size += shard->index.size();
+    }
+    return size;
+  }
+
+  auto Capacity() const noexcept -> std::size_t {
+    return shards_.size() * shards_.front()->slots.size();
+  }
+
+  auto GetStats() const noexcept -> Stats {
+    auto stats = Stats{0, 0, 0, 0, 0, 0};
+    for (auto const& shard : shards_) {
+      stats.hits += shard->hits.load(std::memory_order_relaxed);
+      stats.negative_hits +=
+          shard->negative_hits.load(std::memory_order_relaxed);
+      stats.misses += shard->misses.load(std::memory_order_relaxed);
+      stats.coalesced += shard->coalesced.load(std::memory_order_relaxed);
+      stats.evictions += shard->evictions.load(std::memory_order_relaxed);
+      stats.expirations += shard->expirations.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    KeyType key;
+    ValueType value;
+    Clock::time_point expires;
+  };
+
+  struct Slot {
+    std::unique_ptr<Entry> entry;
+    std::atomic<bool> referenced{false};
+  };
+
+  // computation shared by every caller that missed on the same key
+  class Flight {
+   public:
+    void Finish(ValueType const& result) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      result_ = std::make_unique<ValueType>(result);
+      done_.notify_all();
+    }
+
+    void Fail(std::exception_ptr error) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::move(error);
+      done_.notify_all();
+    }
+
+    auto Await() -> ValueType {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [this] { return result_ || error_; });
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+      return *result_;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::unique_ptr<ValueType> result_;
+    std::exception_ptr error_;
+  };
+
+  struct Shard {
+    Shard(std::size_t capacity, Hash const& hash, KeyEqual const& key_equal)
+        : index(capacity, hash, key_equal), slots(capacity) {
+      free.reserve(capacity);
+      for (auto i = capacity; i > 0; --i) {
+        free.push_back(i - 1);
+      }
+    }
+
+    void Release(std::size_t slot) {
+      index.erase(slots[slot].entry->key);
+      slots[slot].entry.reset();
+      free.push_back(slot);
+    }
+
+    // CLOCK sweep: expired entries go first, referenced ones get a second
+    // chance
+    auto Claim(Clock::time_point const now) -> std::size_t {
+      if (!free.empty()) {
+        auto const slot = free.back();
+        free.pop_back();
+        return slot;
+      }
+      for (;;) {
+        auto& slot = slots[hand];
+        auto const victim = hand;
+        hand = (hand + 1) % slots.size();
+        if (slot.entry->expires <= now) {
+          expirations.fetch_add(1, std::memory_order_relaxed);
+        } else if (slot.referenced.exchange(false,
+                                            std::memory_order_relaxed)) {
+          continue;
+        } else {
+          evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        index.erase(slot.entry->key);
+        slot.entry.reset();
+        return victim;
+      }
+    }
+
+    mutable std::shared_timed_mutex mutex;
+    std::unordered_map<KeyType, std::size_t, Hash, KeyEqual> index;
+    std::unordered_map<KeyType, std::shared_ptr<Flight>, Hash, KeyEqual>
+        flights;
+    std::vector<Slot> slots;
+    std::vector<std::size_t> free;
+    std::size_t hand = 0;
+
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> negative_hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> coalesced{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::uint64_t> expirations{0};
+  };
+
+  auto ShardFor(std::size_t hash) -> Shard& {
+    // high bits pick the shard so the low bits stay useful to the index
+    auto const mixed = static_cast<std::uint64_t>(hash) *
+                       static_cast<std::uint64_t>(0x9e3779b97f4a7c15ULL);
+    return *shards_[static_cast<std::size_t>(mixed >> 32U) % shards_.size()];
+  }
+
+  static void CountHit(Shard& shard, ValueType const& value) {
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    if (value.IsError()) {
+      shard.negative_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void Publish(Shard& shard, KeyType const& key, ValueType const& result,
+               Flight& flight) {
+    auto const ttl = result.IsSuccess() ? success_ttl_ : error_ttl_;
+    {
+      std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+      shard.flights.erase(key);
+      if (ttl > Clock::duration::zero()) {
+        auto const it = shard.index.find(key);
+        if (it != shard.index.end()) {
+          shard.Release(it->second);
+        }
+        auto const now = Clock::now();
+        auto const slot = shard.Claim(now);
+        shard.slots[slot].entry =
+            std::make_unique<Entry>(Entry{key, result, now + ttl});
+        shard.slots[slot].referenced.store(false, std::memory_order_relaxed);
+        shard.index.emplace(key, slot);
+      }
+    }
+    flight.Finish(result);
+  }
+
+  Clock::duration success_ttl_;
+  Clock::duration error_ttl_;
+  Hash hash_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace et
+
+#endif  // ET_MEMO_CACHE_HPP_
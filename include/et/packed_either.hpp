@@ -0,0 +1,193 @@
+#ifndef ET_PACKED_EITHER_HPP_
+#define ET_PACKED_EITHER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// Either of two small integral or enum payloads packed in one machine word.
+// Traits declares the payload types and how many bits each one needs:
+//
+//   struct IdOrErrc {
+//     using SuccessType = std::uint32_t;
+//     using ErrorType = Errc;
+//     static constexpr unsigned kSuccessBits = 31;
+//     static constexpr unsigned kErrorBits = 8;
+//   };
+//
+// The payload occupies the low bits and the tag the highest bit of a
+// std::uint32_t, or of a std::uint64_t when the widest payload needs more
+// than 31 bits. Signed payloads are sign extended on access.
+template <class Traits>
+class PackedEither;
+
+namespace detail {
+
+template <class T, bool = std::is_enum<T>::value>
+struct PackedRaw {
+  using type = T;
+};
+
+template <class T>
+struct PackedRaw<T, true> {
+  using type = std::underlying_type_t<T>;
+};
+
+template <class T>
+using PackedRawType = typename PackedRaw<T>::type;
+
+template <class T, unsigned Bits>
+struct PackedFieldConstraints {
+  static_assert(std::is_integral<PackedRawType<T>>::value &&
+                    !std::is_same<PackedRawType<T>, bool>::value,
+                "[et::PackedEither] payloads must be integral or enum types");
+  static_assert(Bits > 0 && Bits <= sizeof(T) * 8,
+                "[et::PackedEither] payload bit width out of range");
+};
+
+}  // namespace detail
+
+template <class Traits>
+class PackedEither final
+    : detail::PackedFieldConstraints<typename Traits::SuccessType,
+                                     Traits::kSuccessBits>,
+      detail::PackedFieldConstraints<typename Traits::ErrorType,
+                                     Traits::kErrorBits> {
+ public:
+  using SuccessType = typename Traits::SuccessType;
+  using ErrorType = typename Traits::ErrorType;
+
+  static constexpr unsigned kSuccessBits = Traits::kSuccessBits;
+  static constexpr unsigned kErrorBits = Traits::kErrorBits;
+  static constexpr unsigned kPayloadBits =
+      kSuccessBits > kErrorBits ? kSuccessBits : kErrorBits;
+
+  static_assert(kPayloadBits < 64,
+                "[et::PackedEither] payload and tag must fit in 64 bits");
+
+  using WordType = std::conditional_t<kPayloadBits < 32, std::uint32_t,
+                                      std::uint64_t>;
+
+  constexpr PackedEither(Either<SuccessType, void> const& that)
+      : word_(Pack(that.Success(), kSuccessBits)) {}
+
+  constexpr PackedEither(Either<void, ErrorType> const& that)
+      : word_(kTagBit | Pack(that.Error(), kErrorBits)) {}
+
+  // raw word round trip, e.g. for storing in std::atomic<WordType>
+  static constexpr auto FromBits(WordType const word) noexcept
+      -> PackedEither {
+    return PackedEither(word);
+  }
+
+  constexpr auto Bits() const noexcept -> WordType { return word_; }
+
+  constexpr operator bool() const noexcept { return IsSuccess(); }
+
+  constexpr auto IsSuccess() const noexcept -> bool {
+    return (word_ & kTagBit) == 0;
+  }
+  constexpr auto IsError() const noexcept -> bool { return !IsSuccess(); }
+
+  constexpr auto Success() const -> SuccessType {
+    return IsSuccess() ? Unpack<SuccessType>(word_, kSuccessBits)
+                       : (throw BadEitherAccess(
+                             "[et::PackedEither::Success] invalid state "
+                             "access"));
+  }
+
+  constexpr auto Error() const -> ErrorType {
+    return IsError() ? Unpack<ErrorType>(word_, kErrorBits)
+                     : (throw BadEitherAccess(
+                           "[et::PackedEither::Error] invalid state access"));
+  }
+
+ private:
+  static constexpr auto kWordBits = unsigned(sizeof(WordType) * 8);
+  static constexpr auto kTagBit = WordType(WordType(1) << (kWordBits - 1));
+
+  explicit constexpr PackedEither(WordType const word) noexcept
+      : word_(word) {}
+
+  static constexpr auto Mask(unsigned const bits) noexcept -> WordType {
+    return bits >= kWordBits ? WordType(~WordType(0))
+                             : WordType((WordType(1) << bits) - 1);
+  }
+
+  template <class T>
+  static constexpr auto Pack(T const value, unsigned const bits) -> WordType {
+    using Raw = detail::PackedRawType<T>;
+    using Wide = std::conditional_t<std::is_signed<Raw>::value, std::int64_t,
+                                    std::uint64_t>;
+    auto const raw = static_cast<Wide>(static_cast<Raw>(value));
+    auto const max = static_cast<Wide>(
+        std::is_signed<Raw>::value ? (std::uint64_t(1) << (bits - 1)) - 1
+                                   : Mask(bits));
+    auto const min =
+        std::is_signed<Raw>::value ? -max - 1 : static_cast<Wide>(0);
+    return raw < min || raw > max
+               ? throw BadEitherAssign(
+                     "[et::PackedEither] payload exceeds declared bit width")
+               : static_cast<WordType>(static_cast<std::uint64_t>(raw) &
+                                       Mask(bits));
+  }
+
+  template <class T>
+  static constexpr auto Unpack(WordType const word, unsigned const bits) -> T {
+    using Raw = detail::PackedRawType<T>;
+    auto const payload = std::uint64_t(word & Mask(bits));
+    auto const sign = std::uint64_t(1) << (bits - 1);
+    return static_cast<T>(static_cast<Raw>(
+        std::is_signed<Raw>::value && (payload & sign) != 0
+            ? static_cast<std::int64_t>(payload | ~(sign | (sign - 1)))
+            : static_cast<std::int64_t>(payload)));
+  }
+
+  WordType word_;
+};
+
+template <class Traits>
+constexpr bool operator==(PackedEither<Traits> const lhs,
+                          PackedEither<Traits> const rhs) noexcept {
+  return lhs.Bits() == rhs.Bits();
+}
+
+template <class Traits>
+constexpr bool operator!=(PackedEither<Traits> const lhs,
+                          PackedEither<Traits> const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <class Traits>
+std::ostream& operator<<(std::ostream& os, PackedEither<Traits> const e) {
+  using Success = detail::PackedRawType<typename Traits::SuccessType>;
+  using Error = detail::PackedRawType<typename Traits::ErrorType>;
+  if (e) {
+    return os << +static_cast<Success>(e.Success());
+  } else {
+    return os << +static_cast<Error>(e.Error());
+  }
+}
+
+}  // namespace et
+
+namespace std {
+
+template <class Traits>
+struct hash<::et::PackedEither<Traits>> {
+  auto operator()(::et::PackedEither<Traits> const e) const noexcept
+      -> std::size_t {
+    return std::hash<typename ::et::PackedEither<Traits>::WordType>()(
+        e.Bits());
+  }
+};
+
+}  // namespace std
+
+#endif  // ET_PACKED_EITHER_HPP_
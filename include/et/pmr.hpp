@@ -0,0 +1,46 @@
+#ifndef ET_PMR_HPP_
+#define ET_PMR_HPP_
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define ET_HAS_PMR 1
+#endif
+#endif
+
+#ifndef ET_HAS_PMR
+#define ET_HAS_PMR 0
+#endif
+
+#if ET_HAS_PMR
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "et/either.hpp"
+
+namespace et {
+namespace pmr {
+
+// payloads allocating from a std::pmr::memory_resource. An Either of them is
+// allocator aware: it keeps the resource of its payload and constructs every
+// later payload from it, and containers of it hand theirs down through uses
+// allocator construction
+using Allocator = std::pmr::polymorphic_allocator<std::byte>;
+
+using String = std::pmr::string;
+
+template <class T>
+using Vector = std::pmr::vector<T>;
+
+// a result with a message allocated from the same resource
+template <class S>
+using Result = et::Either<S, String>;
+
+}  // namespace pmr
+}  // namespace et
+
+#endif  // ET_HAS_PMR
+
+#endif  // ET_PMR_HPP_
@@ -0,0 +1,150 @@
+#ifndef ET_PTR_EITHER_HPP_
+#define ET_PTR_EITHER_HPP_
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "et/either.hpp"
+
+// lets clang pass PtrEither in a register despite its destructor
+#if defined(__clang__) && defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::trivial_abi)
+#define ET_TRIVIAL_ABI [[clang::trivial_abi]]
+#endif
+#endif
+
+#ifndef ET_TRIVIAL_ABI
+#define ET_TRIVIAL_ABI
+#endif
+
+namespace et {
+
+// Owns either a heap allocated S or a heap allocated E through a single
+// pointer whose lowest (alignment) bit holds the tag. A moved from or null
+// constructed PtrEither is empty: neither success nor error.
+template <class S, class E>
+class ET_TRIVIAL_ABI PtrEither {
+ public:
+  using SuccessType = S;
+  using ErrorType = E;
+
+  static_assert(std::is_object<S>::value && std::is_object<E>::value,
+                "[et::PtrEither] only object types supported");
+  static_assert(alignof(S) >= 2 && alignof(E) >= 2,
+                "[et::PtrEither] payload alignment leaves no room for the tag");
+
+  PtrEither(Either<std::unique_ptr<SuccessType>, void>&& that) noexcept
+      : word_(Encode(std::move(that).Success().release(), 0)) {}
+
+  PtrEither(Either<void, std::unique_ptr<ErrorType>>&& that) noexcept
+      : word_(Encode(std::move(that).Error().release(), kErrorTag)) {}
+
+  template <class... Args>
+  static auto MakeSuccess(Args&&... args) -> PtrEither {
+    return PtrEither(Encode(new SuccessType(std::forward<Args>(args)...), 0));
+  }
+
+  template <class... Args>
+  static auto MakeError(Args&&... args) -> PtrEither {
+    return PtrEither(
+        Encode(new ErrorType(std::forward<Args>(args)...), kErrorTag));
+  }
+
+  PtrEither(PtrEither const&) = delete;
+  PtrEither& operator=(PtrEither const&) = delete;
+
+  PtrEither(PtrEither&& that) noexcept : word_(that.word_) { that.word_ = 0; }
+
+  PtrEither& operator=(PtrEither&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      word_ = that.word_;
+      that.word_ = 0;
+    }
+    return *this;
+  }
+
+  ~PtrEither() { Reset(); }
+
+  operator bool() const noexcept { return IsSuccess(); }
+
+  auto IsSuccess() const noexcept -> bool {
+    return word_ != 0 && (word_ & kErrorTag) == 0;
+  }
+  auto IsError() const noexcept -> bool { return (word_ & kErrorTag) != 0; }
+
+  auto Success() & -> SuccessType& { return *SuccessPtr(); }
+  auto Success() const& -> SuccessType const& { return *SuccessPtr(); }
+
+  // hands ownership back, leaving this empty
+  auto Success() && -> std::unique_ptr<SuccessType> {
+    auto owned = std::unique_ptr<SuccessType>(SuccessPtr());
+    word_ = 0;
+    return owned;
+  }
+
+  auto Error() & -> ErrorType& { return *ErrorPtr(); }
+  auto Error() const& -> ErrorType const& { return *ErrorPtr(); }
+
+  auto Error() && -> std::unique_ptr<ErrorType> {
+    auto owned = std::unique_ptr<ErrorType>(ErrorPtr());
+    word_ = 0;
+    return owned;
+  }
+
+ private:
+  static constexpr auto kErrorTag = std::uintptr_t(1);
+
+  explicit PtrEither(std::uintptr_t const word) noexcept : word_(word) {}
+
+  template <class T>
+  static auto Encode(T* ptr, std::uintptr_t const tag) noexcept
+      -> std::uintptr_t {
+    return ptr == nullptr ? 0 : reinterpret_cast<std::uintptr_t>(ptr) | tag;
+  }
+
+  auto SuccessPtr() const -> SuccessType* {
+    if (!IsSuccess()) {
+      throw BadEitherAccess("[et::PtrEither::Success] invalid state access");
+    }
+    return reinterpret_cast<SuccessType*>(word_);
+  }
+
+  auto ErrorPtr() const -> ErrorType* {
+    if (!IsError()) {
+      throw BadEitherAccess("[et::PtrEither::Error] invalid state access");
+    }
+    return reinterpret_cast<ErrorType*>(word_ & ~kErrorTag);
+  }
+
+  void Reset() noexcept {
+    if (IsSuccess()) {
+      delete reinterpret_cast<SuccessType*>(word_);
+    } else if (IsError()) {
+      delete reinterpret_cast<ErrorType*>(word_ & ~kErrorTag);
+    }
+    word_ = 0;
+  }
+
+  std::uintptr_t word_;
+};
+
+template <class S, class E,
+          class = std::enable_if_t<detail::meta::Conjuction<
+              detail::meta::IsPrintable<S const&>::value,
+              detail::meta::IsPrintable<E const&>::value>::value>>
+std::ostream& operator<<(std::ostream& os, PtrEither<S, E> const& e) {
+  if (e.IsSuccess()) {
+    return os << e.Success();
+  } else if (e.IsError()) {
+    return os << e.Error();
+  }
+  return os;
+}
+
+}  // namespace et
+
+#endif  // ET_PTR_EITHER_HPP_
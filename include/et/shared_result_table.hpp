@@ -0,0 +1,427 @@
+#ifndef ET_SHARED_RESULT_TABLE_HPP_
+#define ET_SHARED_RESULT_TABLE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "et/either.hpp"
+#include "et/sys.hpp"
+
+namespace et {
+
+// why attaching to or creating a SharedResultTable failed
+class SharedTableError {
+ public:
+  enum class Kind {
+    kSystem,           // a syscall failed, see GetErrno()
+    kNotReady,         // the creator has not finished initializing
+    kBadMagic,         // not a SharedResultTable
+    kVersionMismatch,  // table written by another format version
+    kLayoutMismatch,   // S or E differ in size or alignment
+    kSchemaMismatch,   // the caller supplied schema differs
+    kTooSmall,         // region shorter than its header claims
+  };
+
+  explicit constexpr SharedTableError(Kind kind) noexcept
+      : kind_(kind), errno_(0) {}
+
+  explicit constexpr SharedTableError(Errno err) noexcept
+      : kind_(Kind::kSystem), errno_(err) {}
+
+  constexpr auto GetKind() const noexcept -> Kind { return kind_; }
+  constexpr auto GetErrno() const noexcept -> Errno { return errno_; }
+
+ private:
+  Kind kind_;
+  Errno errno_;
+};
+
+constexpr bool operator==(SharedTableError const lhs,
+                          SharedTableError const rhs) noexcept {
+  return lhs.GetKind() == rhs.GetKind() && lhs.GetErrno() == rhs.GetErrno();
+}
+
+constexpr bool operator!=(SharedTableError const lhs,
+                          SharedTableError const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os,
+                                SharedTableError const err) {
+  using Kind = SharedTableError::Kind;
+  switch (err.GetKind()) {
+    case Kind::kSystem:
+      return os << err.GetErrno();
+    case Kind::kNotReady:
+      return os << "shared table not initialized yet";
+    case Kind::kBadMagic:
+      return os << "not a shared result table";
+    case Kind::kVersionMismatch:
+      return os << "shared table format version mismatch";
+    case Kind::kLayoutMismatch:
+      return os << "shared table slot layout mismatch";
+    case Kind::kSchemaMismatch:
+      return os << "shared table schema mismatch";
+    case Kind::kTooSmall:
+      return os << "shared table region too small";
+  }
+  return os;
+}
+
+// why SharedResultTable::Read has no result for a slot
+enum class SharedSlotStatus {
+  kEmpty,  // nothing published yet
+  kBusy,   // a writer kept the slot mid update for every attempt
+};
+
+namespace detail {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && sizeof(int) == 4,
+              "[et::SharedResultTable] needs lock free 32 bit atomics");
+
+// first bytes of the region; every field is fixed width so 32 and 64 bit
+// processes agree on it
+struct SharedTableHeader {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::atomic<std::uint32_t> ready;
+  std::uint64_t layout;
+  std::uint64_t schema;
+  std::uint64_t slots;
+  std::uint64_t slot_size;
+};
+
+static_assert(std::is_standard_layout<SharedTableHeader>::value, "");
+static_assert(offsetof(SharedTableHeader, version) == 8, "");
+static_assert(offsetof(SharedTableHeader, ready) == 12, "");
+static_assert(offsetof(SharedTableHeader, layout) == 16, "");
+static_assert(offsetof(SharedTableHeader, slot_size) == 40, "");
+static_assert(sizeof(SharedTableHeader) == 48, "");
+
+// "etSHRTBL" read as a little endian word
+constexpr std::uint64_t kSharedTableMagic = 0x4C42545248537465ULL;
+constexpr std::uint32_t kSharedTableVersion = 1;
+constexpr std::uint32_t kSlotEmpty = 0;
+constexpr std::uint32_t kSlotSuccess = 1;
+constexpr std::uint32_t kSlotError = 2;
+
+constexpr auto MixLayout(std::uint64_t const hash,
+                         std::uint64_t const value) noexcept -> std::uint64_t {
+  return (hash ^ value) * 0x100000001B3ULL;
+}
+
+// one cache line per slot at least, so writers of neighbouring slots do not
+// invalidate each other
+template <class S, class E>
+struct alignas(64) SharedSlot {
+  static constexpr std::size_t kPayloadSize =
+      sizeof(S) > sizeof(E) ? sizeof(S) : sizeof(E);
+  static constexpr std::size_t kPayloadAlign =
+      alignof(S) > alignof(E) ? alignof(S) : alignof(E);
+
+  // seqlock: odd while a writer updates the slot, bumped by 2 per publish
+  std::atomic<std::uint32_t> sequence;
+  std::uint32_t state;
+  alignas(kPayloadAlign) unsigned char payload[kPayloadSize];
+};
+
+}  // namespace detail
+
+// Fixed number of Either<S, E> slots in a POSIX shared memory object, written
+// by worker processes and read by a supervisor:
+//
+//   // supervisor
+//   auto table = et::SharedResultTable<Summary, Code>::Create("/jobs", n);
+//   // worker, after fork or exec
+//   auto table = et::SharedResultTable<Summary, Code>::Attach("/jobs");
+//   table.Success().Publish(job, Compute(job));
+//
+// S and E must be trivially copyable and should not hold pointers, the bytes
+// are shared as they are. Publishing is a per slot seqlock: writers of the
+// same slot take turns, readers retry instead of waiting and never stall a
+// writer. The header stamps the format version, a fingerprint of the slot
+// layout and a caller supplied schema number; Attach fails on any mismatch.
+template <class S, class E>
+class SharedResultTable {
+  static_assert(std::is_trivially_copyable<S>::value &&
+                    std::is_trivially_copyable<E>::value,
+                "[et::SharedResultTable] payloads must be trivially copyable");
+
+  using Header = detail::SharedTableHeader;
+  using Slot = detail::SharedSlot<S, E>;
+
+  static_assert(std::is_standard_layout<Slot>::value, "");
+
+ public:
+  using SuccessType = S;
+  using ErrorType = E;
+  using ResultType = Either<S, E>;
+
+  static constexpr std::uint64_t kLayout = detail::MixLayout(
+      detail::MixLayout(
+          detail::MixLayout(detail::MixLayout(detail::MixLayout(
+                                                  0xCBF29CE484222325ULL,
+                                                  sizeof(S)),
+                                              alignof(S)),
+                            sizeof(E)),
+          alignof(E)),
+      sizeof(Slot));
+
+  // creates name (which must not exist yet) with slots empty slots
+  static auto Create(char const* name, std::size_t const slots,
+                     std::uint64_t const schema = 0) noexcept
+      -> Either<SharedResultTable, SharedTableError> {
+    auto const fd = sys::ShmOpen(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC,
+                                 S_IRUSR | S_IWUSR);
+    if (!fd) {
+      return Error(SharedTableError(fd.Error()));
+    }
+
+    auto const size = RegionSize(slots);
+    auto const resized =
+        sys::Ftruncate(fd.Success(), static_cast<::off_t>(size));
+    if (!resized) {
+      ::close(fd.Success());
+      ::shm_unlink(name);
+      return Error(SharedTableError(resized.Error()));
+    }
+
+    auto const addr = sys::Mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd.Success(), 0);
+    ::close(fd.Success());
+    if (!addr) {
+      ::shm_unlink(name);
+      return Error(SharedTableError(addr.Error()));
+    }
+
+    auto* const base = static_cast<unsigned char*>(addr.Success());
+    auto* const header = ::new (base) Header();
+    header->magic = detail::kSharedTableMagic;
+    header->version = detail::kSharedTableVersion;
+    header->layout = kLayout;
+    header->schema = schema;
+    header->slots = slots;
+    header->slot_size = sizeof(Slot);
+    for (auto i = std::size_t(0); i < slots; ++i) {
+      ::new (base + kSlotsOffset + i * sizeof(Slot)) Slot();
+    }
+    header->ready.store(1, std::memory_order_release);
+
+    return Success(SharedResultTable(base, size));
+  }
+
+  // maps an existing table, checking it was created for this S, E and schema
+  static auto Attach(char const* name, std::uint64_t const schema = 0) noexcept
+      -> Either<SharedResultTable, SharedTableError> {
+    auto const fd = sys::ShmOpen(name, O_RDWR | O_CLOEXEC);
+    if (!fd) {
+      return Error(SharedTableError(fd.Error()));
+    }
+
+    auto const st = sys::Fstat(fd.Success());
+    if (!st) {
+      ::close(fd.Success());
+      return Error(SharedTableError(st.Error()));
+    }
+    auto const size = static_cast<std::size_t>(st.Success().st_size);
+    if (size < kSlotsOffset) {
+      ::close(fd.Success());
+      return Error(SharedTableError(SharedTableError::Kind::kTooSmall));
+    }
+
+    auto const addr = sys::Mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd.Success(), 0);
+    ::close(fd.Success());
+    if (!addr) {
+      return Error(SharedTableError(addr.Error()));
+    }
+
+    auto table =
+        SharedResultTable(static_cast<unsigned char*>(addr.Success()), size);
+    auto const checked = table.Check(schema);
+    if (!checked) {
+      return Error(checked.Error());
+    }
+    return Success(std::move(table));
+  }
+
+  // removes the name, mappings stay valid until unmapped
+  static auto Unlink(char const* name) noexcept -> Either<int, Errno> {
+    return sys::ShmUnlink(name);
+  }
+
+  SharedResultTable(SharedResultTable const&) = delete;
+  SharedResultTable& operator=(SharedResultTable const&) = delete;
+
+  SharedResultTable(SharedResultTable&& that) noexcept
+      : base_(std::exchange(that.base_, nullptr)),
+        size_(std::exchange(that.size_, 0)) {}
+
+  SharedResultTable& operator=(SharedResultTable&& that) noexcept {
+    if (this != &that) {
+      Unmap();
+      base_ = std::exchange(that.base_, nullptr);
+      size_ = std::exchange(that.size_, 0);
+    }
+    return *this;
+  }
+
+  ~SharedResultTable() { Unmap(); }
+
+  auto Slots() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(GetHeader()->slots);
+  }
+
+  // makes result the slot's latest value; an empty result throws
+  // BadEitherAccess and leaves the slot as it was
+  void Publish(std::size_t const slot, ResultType const& result) {
+    auto& target = SlotAt(slot, "[et::SharedResultTable::Publish]");
+    // checked before locking, a throw while the sequence is odd would leave
+    // the slot busy for good
+    if (ET_UNLIKELY(result.IsEmpty())) {
+      throw BadEitherAccess("[et::SharedResultTable::Publish] empty result");
+    }
+
+    auto sequence = target.sequence.load(std::memory_order_relaxed);
+    for (;;) {
+      if ((sequence & 1U) == 0 &&
+          target.sequence.compare_exchange_weak(sequence, sequence + 1,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+        break;
+      }
+      std::this_thread::yield();
+      sequence = target.sequence.load(std::memory_order_relaxed);
+    }
+    // the odd sequence is visible before any payload byte changes
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (result.IsSuccess()) {
+      target.state = detail::kSlotSuccess;
+      std::memcpy(target.payload, &result.Success(), sizeof(S));
+    } else {
+      target.state = detail::kSlotError;
+      std::memcpy(target.payload, &result.Error(), sizeof(E));
+    }
+    target.sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // latest result published to slot; retries up to attempts times while a
+  // writer is mid update and never blocks it
+  auto Read(std::size_t const slot, unsigned const attempts = 64) const
+      -> Either<ResultType, SharedSlotStatus> {
+    auto const& source = SlotAt(slot, "[et::SharedResultTable::Read]");
+
+    for (auto attempt = 0U; attempt < attempts; ++attempt) {
+      auto const before = source.sequence.load(std::memory_order_acquire);
+      if (before == 0) {
+        return Error(SharedSlotStatus::kEmpty);
+      }
+      if ((before & 1U) != 0) {
+        continue;
+      }
+
+      alignas(Slot::kPayloadAlign) unsigned char copy[Slot::kPayloadSize];
+      auto const state = source.state;
+      std::memcpy(copy, source.payload, sizeof(copy));
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (source.sequence.load(std::memory_order_relaxed) == before) {
+        if (state == detail::kSlotSuccess) {
+          return Success(
+              ResultType(Success(*reinterpret_cast<S const*>(copy))));
+        }
+        return Success(ResultType(Error(*reinterpret_cast<E const*>(copy))));
+      }
+    }
+    return Error(SharedSlotStatus::kBusy);
+  }
+
+  // number of results published to slot so far
+  auto Publications(std::size_t const slot) const -> std::uint32_t {
+    auto const& source = SlotAt(slot, "[et::SharedResultTable::Publications]");
+    return source.sequence.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  static constexpr std::size_t kSlotsOffset =
+      (sizeof(Header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+  static constexpr auto RegionSize(std::size_t const slots) noexcept
+      -> std::size_t {
+    return kSlotsOffset + slots * sizeof(Slot);
+  }
+
+  SharedResultTable(unsigned char* base, std::size_t size) noexcept
+      : base_(base), size_(size) {}
+
+  auto GetHeader() const noexcept -> Header* {
+    return reinterpret_cast<Header*>(base_);
+  }
+
+  auto Check(std::uint64_t const schema) const noexcept
+      -> Either<int, SharedTableError> {
+    using Kind = SharedTableError::Kind;
+    auto const* const header = GetHeader();
+    if (header->ready.load(std::memory_order_acquire) == 0) {
+      return Error(SharedTableError(Kind::kNotReady));
+    }
+    if (header->magic != detail::kSharedTableMagic) {
+      return Error(SharedTableError(Kind::kBadMagic));
+    }
+    if (header->version != detail::kSharedTableVersion) {
+      return Error(SharedTableError(Kind::kVersionMismatch));
+    }
+    if (header->layout != kLayout || header->slot_size != sizeof(Slot)) {
+      return Error(SharedTableError(Kind::kLayoutMismatch));
+    }
+    if (header->schema != schema) {
+      return Error(SharedTableError(Kind::kSchemaMismatch));
+    }
+    if (header->slots > (size_ - kSlotsOffset) / sizeof(Slot)) {
+      return Error(SharedTableError(Kind::kTooSmall));
+    }
+    return Success(0);
+  }
+
+  auto SlotAt(std::size_t const slot, char const* what) const -> Slot& {
+    if (ET_UNLIKELY(slot >= Slots())) {
+      throw std::out_of_range(std::string(what) + " slot out of range");
+    }
+    return *reinterpret_cast<Slot*>(base_ + kSlotsOffset + slot * sizeof(Slot));
+  }
+
+  void Unmap() noexcept {
+    if (base_ != nullptr) {
+      ::munmap(base_, size_);
+      base_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  unsigned char* base_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+template <class S, class E>
+constexpr std::uint64_t SharedResultTable<S, E>::kLayout;
+
+template <class S, class E>
+constexpr std::size_t SharedResultTable<S, E>::kSlotsOffset;
+
+}  // namespace et
+
+#endif  // ET_SHARED_RESULT_TABLE_HPP_
@@ -0,0 +1,129 @@
+#ifndef ET_STATIC_ERROR_HPP_
+#define ET_STATIC_ERROR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+
+#include "et/either.hpp"
+
+namespace et {
+
+enum class ErrorSeverity : std::uint8_t { kInfo, kWarning, kError, kFatal };
+
+inline std::ostream& operator<<(std::ostream& os, ErrorSeverity const s) {
+  switch (s) {
+    case ErrorSeverity::kInfo:
+      return os << "info";
+    case ErrorSeverity::kWarning:
+      return os << "warning";
+    case ErrorSeverity::kError:
+      return os << "error";
+    case ErrorSeverity::kFatal:
+      return os << "fatal";
+  }
+  return os;
+}
+
+struct ErrorDescriptor {
+  char const* message;
+  std::uint32_t id;
+  ErrorSeverity severity;
+};
+
+namespace detail {
+
+// one descriptor per tag; static members of class templates are merged
+// across translation units, so the descriptor address identifies the error
+template <class Tag>
+struct StaticErrorRegistry {
+  static constexpr ErrorDescriptor kDescriptor = Tag::Describe();
+};
+
+template <class Tag>
+constexpr ErrorDescriptor StaticErrorRegistry<Tag>::kDescriptor;
+
+}  // namespace detail
+
+// Error referring to a descriptor with static storage duration: creating
+// one stores a single pointer and equality compares pointers. Defined
+// through ET_DEFINE_STATIC_ERROR or inline through ET_STATIC_ERROR.
+class StaticError {
+ public:
+  template <class Tag>
+  static constexpr auto Of() noexcept -> StaticError {
+    return StaticError(detail::StaticErrorRegistry<Tag>::kDescriptor);
+  }
+
+  explicit constexpr StaticError(ErrorDescriptor const& descriptor) noexcept
+      : descriptor_(&descriptor) {}
+
+  constexpr auto Message() const noexcept -> char const* {
+    return descriptor_->message;
+  }
+
+  constexpr auto Id() const noexcept -> std::uint32_t {
+    return descriptor_->id;
+  }
+
+  constexpr auto Severity() const noexcept -> ErrorSeverity {
+    return descriptor_->severity;
+  }
+
+  constexpr auto Descriptor() const noexcept -> ErrorDescriptor const& {
+    return *descriptor_;
+  }
+
+ private:
+  ErrorDescriptor const* descriptor_;
+};
+
+constexpr bool operator==(StaticError const lhs,
+                          StaticError const rhs) noexcept {
+  return &lhs.Descriptor() == &rhs.Descriptor();
+}
+
+constexpr bool operator!=(StaticError const lhs,
+                          StaticError const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, StaticError const err) {
+  return os << err.Severity() << " #" << err.Id() << ": " << err.Message();
+}
+
+}  // namespace et
+
+namespace std {
+
+template <>
+struct hash<::et::StaticError> {
+  auto operator()(::et::StaticError const err) const noexcept -> std::size_t {
+    return std::hash<::et::ErrorDescriptor const*>()(&err.Descriptor());
+  }
+};
+
+}  // namespace std
+
+// namespace scope constant usable in constant expressions:
+//   ET_DEFINE_STATIC_ERROR(kNotFound, 404, et::ErrorSeverity::kError,
+//                          "[storage::Load] error: key not found");
+#define ET_DEFINE_STATIC_ERROR(name, id, severity, message)                    \
+  struct name##StaticErrorTag {                                                \
+    static constexpr auto Describe() noexcept -> ::et::ErrorDescriptor {       \
+      return ::et::ErrorDescriptor{message, id, severity};                     \
+    }                                                                          \
+  };                                                                           \
+  constexpr auto name = ::et::StaticError::Of<name##StaticErrorTag>()
+
+// expression form for one off call sites:
+//   return et::Error(ET_STATIC_ERROR(7, et::ErrorSeverity::kWarning, "..."));
+#define ET_STATIC_ERROR(id, severity, message)                                 \
+  ([]() noexcept -> ::et::StaticError {                                        \
+    static constexpr auto kDescriptor =                                        \
+        ::et::ErrorDescriptor{message, id, severity};                          \
+    return ::et::StaticError(kDescriptor);                                     \
+  }())
+
+#endif  // ET_STATIC_ERROR_HPP_
@@ -0,0 +1,168 @@
+#ifndef ET_SYS_HPP_
+#define ET_SYS_HPP_
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "et/either.hpp"
+
+namespace et {
+
+// errno captured as a value, 4 bytes wide so Either<ssize_t, Errno> stays at
+// 16 bytes and travels in a register pair
+class Errno {
+ public:
+  explicit constexpr Errno(int value) noexcept : value_(value) {}
+
+  static auto Last() noexcept -> Errno { return Errno(errno); }
+
+  constexpr auto Value() const noexcept -> int { return value_; }
+
+  auto Message() const -> std::string { return std::strerror(value_); }
+
+ private:
+  int value_;
+};
+
+constexpr bool operator==(Errno const lhs, Errno const rhs) noexcept {
+  return lhs.Value() == rhs.Value();
+}
+
+constexpr bool operator!=(Errno const lhs, Errno const rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, Errno const err) {
+  return os << "errno " << err.Value() << ": " << err.Message();
+}
+
+namespace sys {
+
+template <class T>
+using Result = Either<T, Errno>;
+
+namespace detail {
+
+// -1/errno convention shared by most of the syscalls wrapped below
+template <class T>
+inline auto FromRet(T const ret) noexcept -> Result<T> {
+  if (ET_UNLIKELY(ret == static_cast<T>(-1))) {
+    return Error(Errno::Last());
+  }
+  return Success(ret);
+}
+
+}  // namespace detail
+
+inline auto Open(char const* path, int flags, ::mode_t mode = 0) noexcept
+    -> Result<int> {
+  return detail::FromRet(::open(path, flags, mode));
+}
+
+inline auto Close(int fd) noexcept -> Result<int> {
+  return detail::FromRet(::close(fd));
+}
+
+inline auto Read(int fd, void* buf, std::size_t count) noexcept
+    -> Result<::ssize_t> {
+  return detail::FromRet(::read(fd, buf, count));
+}
+
+inline auto Write(int fd, void const* buf, std::size_t count) noexcept
+    -> Result<::ssize_t> {
+  return detail::FromRet(::write(fd, buf, count));
+}
+
+inline auto Pread(int fd, void* buf, std::size_t count, ::off_t offset) noexcept
+    -> Result<::ssize_t> {
+  return detail::FromRet(::pread(fd, buf, count, offset));
+}
+
+inline auto Pwrite(int fd, void const* buf, std::size_t count,
+                   ::off_t offset) noexcept -> Result<::ssize_t> {
+  return detail::FromRet(::pwrite(fd, buf, count, offset));
+}
+
+inline auto Lseek(int fd, ::off_t offset, int whence) noexcept
+    -> Result<::off_t> {
+  return detail::FromRet(::lseek(fd, offset, whence));
+}
+
+inline auto Ftruncate(int fd, ::off_t length) noexcept -> Result<int> {
+  return detail::FromRet(::ftruncate(fd, length));
+}
+
+inline auto Fsync(int fd) noexcept -> Result<int> {
+  return detail::FromRet(::fsync(fd));
+}
+
+inline auto Flock(int fd, int operation) noexcept -> Result<int> {
+  return detail::FromRet(::flock(fd, operation));
+}
+
+inline auto Fstat(int fd) noexcept -> Result<struct ::stat> {
+  struct ::stat st;
+  if (ET_UNLIKELY(::fstat(fd, &st) == -1)) {
+    return Error(Errno::Last());
+  }
+  return Success(st);
+}
+
+// mmap reports failure through MAP_FAILED instead of -1
+inline auto Mmap(void* addr, std::size_t length, int prot, int flags, int fd,
+                 ::off_t offset) noexcept -> Result<void*> {
+  void* const ptr = ::mmap(addr, length, prot, flags, fd, offset);
+  if (ET_UNLIKELY(ptr == MAP_FAILED)) {
+    return Error(Errno::Last());
+  }
+  return Success(ptr);
+}
+
+inline auto Munmap(void* addr, std::size_t length) noexcept -> Result<int> {
+  return detail::FromRet(::munmap(addr, length));
+}
+
+inline auto Madvise(void* addr, std::size_t length, int advice) noexcept
+    -> Result<int> {
+  return detail::FromRet(::madvise(addr, length, advice));
+}
+
+inline auto Msync(void* addr, std::size_t length, int flags) noexcept
+    -> Result<int> {
+  return detail::FromRet(::msync(addr, length, flags));
+}
+
+inline auto ShmOpen(char const* name, int flags, ::mode_t mode = 0) noexcept
+    -> Result<int> {
+  return detail::FromRet(::shm_open(name, flags, mode));
+}
+
+inline auto ShmUnlink(char const* name) noexcept -> Result<int> {
+  return detail::FromRet(::shm_unlink(name));
+}
+
+}  // namespace sys
+
+namespace detail {
+namespace asserts {
+
+static_assert(sizeof(Errno) == 4, "");
+static_assert(sizeof(sys::Result<::ssize_t>) == 16, "");
+static_assert(std::is_trivially_copyable<sys::Result<::ssize_t>>::value, "");
+
+}  // namespace asserts
+}  // namespace detail
+
+}  // namespace et
+
+#endif  // ET_SYS_HPP_
@@ -0,0 +1,352 @@
+#ifndef ET_URING_HPP_
+#define ET_URING_HPP_
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ET_HAS_URING 1
+#endif
+#endif
+
+#ifndef ET_HAS_URING
+#define ET_HAS_URING 0
+#endif
+
+#if ET_HAS_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "et/either.hpp"
+#include "et/sys.hpp"
+
+namespace et {
+namespace uring {
+
+// single read or write submission; a non negative buf_index selects a buffer
+// registered through Ring::RegisterBuffers and the fixed buffer opcodes
+struct Op {
+  enum class Kind : std::uint8_t { kRead, kWrite };
+
+  static constexpr auto Read(int fd, void* buf, std::uint32_t len,
+                             std::uint64_t offset,
+                             std::uint64_t user_data) noexcept -> Op {
+    return Op{Kind::kRead, fd, buf, len, offset, user_data, -1};
+  }
+
+  static constexpr auto Write(int fd, void const* buf, std::uint32_t len,
+                              std::uint64_t offset,
+                              std::uint64_t user_data) noexcept -> Op {
+    return Op{Kind::kWrite,  fd,        const_cast<void*>(buf), len,
+              offset,        user_data, -1};
+  }
+
+  constexpr auto WithFixedBuffer(int index) const noexcept -> Op {
+    return Op{kind, fd, buf, len, offset, user_data, index};
+  }
+
+  Kind kind;
+  int fd;
+  void* buf;
+  std::uint32_t len;
+  std::uint64_t offset;
+  std::uint64_t user_data;
+  int buf_index;
+};
+
+struct Completion {
+  std::uint64_t user_data;
+  Either<std::size_t, Errno> result;
+};
+
+namespace detail {
+
+inline auto Setup(unsigned entries, ::io_uring_params* params) noexcept
+    -> Either<int, Errno> {
+  return sys::detail::FromRet(
+      static_cast<int>(::syscall(__NR_io_uring_setup, entries, params)));
+}
+
+inline auto Enter(int fd, unsigned to_submit, unsigned min_complete,
+                  unsigned flags) noexcept -> Either<int, Errno> {
+  return sys::detail::FromRet(static_cast<int>(::syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0)));
+}
+
+inline auto Register(int fd, unsigned opcode, void const* arg,
+                     unsigned nr_args) noexcept -> Either<int, Errno> {
+  return sys::detail::FromRet(static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args)));
+}
+
+template <class T>
+auto At(void* base, std::uint32_t offset) noexcept -> T* {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+}  // namespace detail
+
+// io_uring instance driven through the raw kernel interface; owns the ring
+// mappings and the ring file descriptor
+class Ring {
+ public:
+  static auto Create(unsigned entries) noexcept -> Either<Ring, Errno> {
+    auto params = ::io_uring_params{};
+    auto const fd = detail::Setup(entries, &params);
+    if (!fd) {
+      return Error(fd.Error());
+    }
+
+    auto ring = Ring();
+    ring.fd_ = fd.Success();
+    ring.sq_entries_ = params.sq_entries;
+
+    ring.sq_ring_size_ =
+        params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    ring.cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+    auto const single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      ring.sq_ring_size_ = ring.cq_ring_size_ =
+          std::max(ring.sq_ring_size_, ring.cq_ring_size_);
+    }
+
+    auto const sq_ring =
+        sys::Mmap(nullptr, ring.sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring.fd_, IORING_OFF_SQ_RING);
+    if (!sq_ring) {
+      return Error(sq_ring.Error());
+    }
+    ring.sq_ring_ = sq_ring.Success();
+
+    if (single_mmap) {
+      ring.cq_ring_ = ring.sq_ring_;
+    } else {
+      auto const cq_ring =
+          sys::Mmap(nullptr, ring.cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring.fd_, IORING_OFF_CQ_RING);
+      if (!cq_ring) {
+        return Error(cq_ring.Error());
+      }
+      ring.cq_ring_ = cq_ring.Success();
+    }
+
+    ring.sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+    auto const sqes =
+        sys::Mmap(nullptr, ring.sqes_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring.fd_, IORING_OFF_SQES);
+    if (!sqes) {
+      return Error(sqes.Error());
+    }
+    ring.sqes_ = static_cast<::io_uring_sqe*>(sqes.Success());
+
+    ring.sq_head_ = detail::At<std::uint32_t>(ring.sq_ring_, params.sq_off.head);
+    ring.sq_tail_ = detail::At<std::uint32_t>(ring.sq_ring_, params.sq_off.tail);
+    ring.sq_mask_ =
+        *detail::At<std::uint32_t>(ring.sq_ring_, params.sq_off.ring_mask);
+    ring.sq_array_ =
+        detail::At<std::uint32_t>(ring.sq_ring_, params.sq_off.array);
+
+    ring.cq_head_ = detail::At<std::uint32_t>(ring.cq_ring_, params.cq_off.head);
+    ring.cq_tail_ = detail::At<std::uint32_t>(ring.cq_ring_, params.cq_off.tail);
+    ring.cq_mask_ =
+        *detail::At<std::uint32_t>(ring.cq_ring_, params.cq_off.ring_mask);
+    ring.cqes_ = detail::At<::io_uring_cqe>(ring.cq_ring_, params.cq_off.cqes);
+
+    return Success(std::move(ring));
+  }
+
+  Ring(Ring const&) = delete;
+  Ring& operator=(Ring const&) = delete;
+
+  Ring(Ring&& that) noexcept { Swap(that); }
+
+  Ring& operator=(Ring&& that) noexcept {
+    if (this != &that) {
+      Release();
+      Swap(that);
+    }
+    return *this;
+  }
+
+  ~Ring() { Release(); }
+
+  auto Capacity() const noexcept -> std::size_t { return sq_entries_; }
+
+  auto RegisterBuffers(::iovec const* iovs, unsigned count) noexcept
+      -> Either<int, Errno> {
+    return detail::Register(fd_, IORING_REGISTER_BUFFERS, iovs, count);
+  }
+
+  auto UnregisterBuffers() noexcept -> Either<int, Errno> {
+    return detail::Register(fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+  }
+
+  // queues as many ops as there are free submission slots and hands them to
+  // the kernel with a single io_uring_enter; yields the number submitted,
+  // ops[0, n). Entries the kernel did not consume, all of them on error, are
+  // taken back out of the ring, so ops[n, count) are simply not submitted
+  // and nothing is left over for the next batch. (The ring is set up without
+  // SQPOLL, so the kernel only reads the tail inside io_uring_enter.)
+  auto SubmitBatch(Op const* ops, std::size_t count) noexcept
+      -> Either<std::size_t, Errno> {
+    auto tail = *sq_tail_;
+    auto const head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    auto const queued = std::min<std::size_t>(count, sq_entries_ - (tail - head));
+
+    for (auto i = std::size_t(0); i < queued; ++i, ++tail) {
+      auto const index = tail & sq_mask_;
+      Prepare(sqes_ + index, ops[i]);
+      sq_array_[index] = index;
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    auto const submitted =
+        detail::Enter(fd_, static_cast<unsigned>(queued), 0, 0);
+    // rolls the tail back to the first entry the kernel left behind
+    auto const consumed = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (consumed != tail) {
+      __atomic_store_n(sq_tail_, consumed, __ATOMIC_RELEASE);
+    }
+    if (!submitted) {
+      return Error(submitted.Error());
+    }
+    return Success(static_cast<std::size_t>(consumed - head));
+  }
+
+  template <class Ops>
+  auto SubmitBatch(Ops const& ops) noexcept -> Either<std::size_t, Errno> {
+    return SubmitBatch(ops.data(), ops.size());
+  }
+
+  // blocks until at least min_complete completions are ready; yields the
+  // number of completions available for Reap
+  auto Wait(std::size_t min_complete) noexcept -> Either<std::size_t, Errno> {
+    if (Ready() < min_complete) {
+      auto const entered = detail::Enter(
+          fd_, 0, static_cast<unsigned>(min_complete), IORING_ENTER_GETEVENTS);
+      if (!entered) {
+        return Error(entered.Error());
+      }
+    }
+    return Success(Ready());
+  }
+
+  auto Ready() const noexcept -> std::size_t {
+    return __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) - *cq_head_;
+  }
+
+  // hands every ready completion to on_completion and releases the whole
+  // batch back to the kernel with one head update
+  template <class F>
+  auto Reap(F&& on_completion) -> std::size_t {
+    auto head = *cq_head_;
+    auto const tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      auto const& cqe = cqes_[head & cq_mask_];
+      if (cqe.res < 0) {
+        on_completion(Completion{cqe.user_data, Error(Errno(-cqe.res))});
+      } else {
+        on_completion(Completion{
+            cqe.user_data, Success(static_cast<std::size_t>(cqe.res))});
+      }
+    }
+
+    auto const reaped = static_cast<std::size_t>(head - *cq_head_);
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return reaped;
+  }
+
+ private:
+  Ring() noexcept = default;
+
+  static void Prepare(::io_uring_sqe* sqe, Op const& op) noexcept {
+    std::memset(sqe, 0, sizeof(*sqe));
+    auto const fixed = op.buf_index >= 0;
+    if (op.kind == Op::Kind::kRead) {
+      sqe->opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    } else {
+      sqe->opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    }
+    sqe->fd = op.fd;
+    sqe->addr = reinterpret_cast<std::uintptr_t>(op.buf);
+    sqe->len = op.len;
+    sqe->off = op.offset;
+    sqe->user_data = op.user_data;
+    if (fixed) {
+      sqe->buf_index = static_cast<std::uint16_t>(op.buf_index);
+    }
+  }
+
+  void Swap(Ring& that) noexcept {
+    std::swap(fd_, that.fd_);
+    std::swap(sq_entries_, that.sq_entries_);
+    std::swap(sq_ring_, that.sq_ring_);
+    std::swap(cq_ring_, that.cq_ring_);
+    std::swap(sq_ring_size_, that.sq_ring_size_);
+    std::swap(cq_ring_size_, that.cq_ring_size_);
+    std::swap(sqes_, that.sqes_);
+    std::swap(sqes_size_, that.sqes_size_);
+    std::swap(sq_head_, that.sq_head_);
+    std::swap(sq_tail_, that.sq_tail_);
+    std::swap(sq_mask_, that.sq_mask_);
+    std::swap(sq_array_, that.sq_array_);
+    std::swap(cq_head_, that.cq_head_);
+    std::swap(cq_tail_, that.cq_tail_);
+    std::swap(cq_mask_, that.cq_mask_);
+    std::swap(cqes_, that.cqes_);
+  }
+
+  void Release() noexcept {
+    if (sqes_ != nullptr) {
+      ::munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != nullptr) {
+      ::munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+    fd_ = -1;
+    sq_ring_ = cq_ring_ = nullptr;
+    sqes_ = nullptr;
+  }
+
+  int fd_ = -1;
+  std::uint32_t sq_entries_ = 0;
+
+  void* sq_ring_ = nullptr;
+  void* cq_ring_ = nullptr;
+  std::size_t sq_ring_size_ = 0;
+  std::size_t cq_ring_size_ = 0;
+  ::io_uring_sqe* sqes_ = nullptr;
+  std::size_t sqes_size_ = 0;
+
+  std::uint32_t* sq_head_ = nullptr;
+  std::uint32_t* sq_tail_ = nullptr;
+  std::uint32_t sq_mask_ = 0;
+  std::uint32_t* sq_array_ = nullptr;
+
+  std::uint32_t* cq_head_ = nullptr;
+  std::uint32_t* cq_tail_ = nullptr;
+  std::uint32_t cq_mask_ = 0;
+  ::io_uring_cqe* cqes_ = nullptr;
+};
+
+}  // namespace uring
+}  // namespace et
+
+#endif  // ET_HAS_URING
+
+#endif  // ET_URING_HPP_
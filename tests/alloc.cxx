@@ -0,0 +1,171 @@
+#include "et/alloc.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+
+namespace {
+
+using Kind = et::AllocError::Kind;
+
+struct alignas(64) Line {
+  unsigned char bytes[64];
+};
+
+struct Throws {
+  explicit Throws(bool const fail) {
+    if (fail) {
+      throw std::runtime_error("Throws");
+    }
+  }
+};
+
+}  // namespace
+
+TEST_CASE("TryAllocate returns storage or an error", "[alloc]") {
+  auto const before = counting::ThreadAllocations();
+  auto ints = et::TryAllocate<std::int32_t>(16);
+  REQUIRE(ints.IsSuccess());
+  for (auto i = 0; i < 16; ++i) {
+    ints.Success()[i] = i;
+  }
+  CHECK(ints.Success()[15] == 15);
+  et::Deallocate(ints.Success());
+  // counting.cxx replaces the nothrow operator new too, so this is exact
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news - before.news == 1);
+  CHECK(after.deletes - before.deletes == 1);
+
+  auto const too_large = et::TryAllocate<std::int32_t>(
+      std::numeric_limits<std::size_t>::max() / 2);
+  REQUIRE(too_large.IsError());
+  CHECK(too_large.Error().GetKind() == Kind::kTooLarge);
+
+#if !defined(__SANITIZE_ADDRESS__)
+  // fits std::size_t, not any address space
+  auto const huge = et::TryAllocate<unsigned char>(
+      std::numeric_limits<std::size_t>::max() / 2);
+  REQUIRE(huge.IsError());
+  CHECK(huge.Error() ==
+        et::AllocError(Kind::kOutOfMemory,
+                       std::numeric_limits<std::size_t>::max() / 2));
+#endif
+
+#if defined(__cpp_aligned_new)
+  auto lines = et::TryAllocate<Line>(3);
+  REQUIRE(lines.IsSuccess());
+  CHECK(reinterpret_cast<std::uintptr_t>(lines.Success()) % 64 == 0);
+  et::Deallocate(lines.Success());
+#endif
+}
+
+TEST_CASE("TryMakeUnique constructs or reports the allocation", "[alloc]") {
+  auto made = et::TryMakeUnique<std::vector<int>>(3, 7);
+  REQUIRE(made.IsSuccess());
+  CHECK(*made.Success() == std::vector<int>{7, 7, 7});
+
+  auto const before = counting::ThreadAllocations();
+  CHECK_THROWS_AS(et::TryMakeUnique<Throws>(true), std::runtime_error);
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news - before.news == after.deletes - before.deletes);
+}
+
+TEST_CASE("BumpAllocator aligns and runs out", "[alloc]") {
+  auto created = et::BumpAllocator::Create(64);
+  REQUIRE(created.IsSuccess());
+  auto& bump = created.Success();
+  CHECK(bump.Capacity() == 64);
+
+  auto const byte = bump.Allocate<char>();
+  REQUIRE(byte.IsSuccess());
+  auto const word = bump.Allocate<std::uint64_t>(2);
+  REQUIRE(word.IsSuccess());
+  CHECK(reinterpret_cast<std::uintptr_t>(word.Success()) % 8 == 0);
+  CHECK(bump.Used() == 24);
+
+  auto const full = bump.Allocate<std::uint64_t>(6);
+  REQUIRE(full.IsError());
+  CHECK(full.Error() == et::AllocError(Kind::kExhausted, 48));
+  CHECK(bump.Used() == 24);
+  CHECK(bump.Allocate<std::uint64_t>(5).IsSuccess());
+  CHECK(bump.Used() == 64);
+
+  bump.Reset();
+  CHECK(bump.Used() == 0);
+  CHECK(bump.Allocate<char>(64).IsSuccess());
+
+  // the new owner frees the buffer, the old one hands out nothing more
+  auto moved = std::move(bump);
+  CHECK(moved.Used() == 64);
+  CHECK(bump.Capacity() == 0);
+  CHECK(bump.Used() == 0);
+  CHECK(bump.Allocate<char>().IsError());
+  moved.Reset();
+  CHECK(moved.Allocate<char>().IsSuccess());
+
+  // rounding the capacity up to whole std::max_align_t would wrap around
+  auto const huge =
+      et::BumpAllocator::Create(std::numeric_limits<std::size_t>::max() - 3);
+  REQUIRE(huge.IsError());
+  CHECK(huge.Error().GetKind() == Kind::kTooLarge);
+
+  // over a caller's buffer, nothing allocated
+  alignas(8) unsigned char buffer[16];
+  auto const before = counting::ThreadAllocations();
+  auto local = et::BumpAllocator(buffer, sizeof(buffer));
+  CHECK(local.Allocate<std::uint32_t>(4).Success() ==
+        static_cast<void*>(buffer));
+  CHECK(local.Allocate<char>().IsError());
+  CHECK(counting::ThreadAllocations().news == before.news);
+}
+
+TEST_CASE("PoolAllocator recycles its slots", "[alloc]") {
+  auto created = et::PoolAllocator<std::string>::Create(3);
+  REQUIRE(created.IsSuccess());
+  auto& pool = created.Success();
+  CHECK(pool.Slots() == 3);
+
+  auto slots = std::vector<std::string*>();
+  for (auto i = 0; i < 3; ++i) {
+    auto slot = pool.Allocate();
+    REQUIRE(slot.IsSuccess());
+    slots.push_back(new (slot.Success()) std::string(std::to_string(i)));
+  }
+  CHECK(pool.Available() == 0);
+  auto const exhausted = pool.Allocate();
+  REQUIRE(exhausted.IsError());
+  CHECK(exhausted.Error().GetKind() == Kind::kExhausted);
+
+  auto* const middle = slots[1];
+  middle->~basic_string();
+  pool.Deallocate(middle);
+  CHECK(pool.Available() == 1);
+  CHECK(pool.Allocate().Success() == middle);
+
+  for (auto* const slot : {slots[0], slots[2]}) {
+    slot->~basic_string();
+    pool.Deallocate(slot);
+  }
+  CHECK(pool.Available() == 2);
+
+  auto moved = std::move(pool);
+  CHECK(moved.Slots() == 3);
+  CHECK(moved.Available() == 2);
+  CHECK(pool.Slots() == 0);
+  CHECK(pool.Available() == 0);
+  CHECK(pool.Allocate().IsError());
+}
+
+TEST_CASE("AllocError prints its kind", "[alloc]") {
+  auto os = std::ostringstream();
+  os << et::AllocError(Kind::kExhausted, 48);
+  CHECK(os.str() == "allocator exhausted allocating 48 bytes");
+}
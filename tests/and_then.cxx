@@ -0,0 +1,191 @@
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+#include "et/either.hpp"
+
+namespace {
+
+enum class ParseError : std::uint8_t { kNotANumber = 1 };
+enum class IoError : std::int32_t { kEof = 2, kClosed = 3 };
+
+std::ostream& operator<<(std::ostream& os, ParseError) {
+  return os << "not a number";
+}
+
+std::ostream& operator<<(std::ostream& os, IoError const error) {
+  return os << "io " << static_cast<int>(error);
+}
+
+struct Message {
+  std::string text;
+};
+
+bool operator==(Message const& lhs, Message const& rhs) {
+  return lhs.text == rhs.text;
+}
+
+// declared common type of two error types
+struct AppError {
+  AppError(ParseError) : code(1) {}
+  AppError(IoError const error) : code(static_cast<int>(error)) {}
+
+  int code;
+};
+
+}  // namespace
+
+namespace et {
+
+template <>
+struct CommonError<IoError, ParseError> {
+  using type = AppError;
+};
+
+}  // namespace et
+
+namespace {
+
+auto Parse(std::string const& text) -> et::Either<int, ParseError> {
+  if (text.empty() || text.find_first_not_of("0123456789") != text.npos) {
+    return et::Error(ParseError::kNotANumber);
+  }
+  return et::Success(std::stoi(text));
+}
+
+auto Read(int const fd) -> et::Either<std::int64_t, IoError> {
+  if (fd == 0) {
+    return et::Error(IoError::kEof);
+  }
+  return et::Success(std::int64_t(fd) * 10);
+}
+
+auto Name(std::int64_t const size) -> et::Either<std::string, Message> {
+  if (size > 1000) {
+    return et::Error(Message{"too large: " + std::to_string(size)});
+  }
+  return et::Success(std::to_string(size) + " bytes");
+}
+
+auto Half(std::int64_t const size) -> et::Either<std::int64_t, void> {
+  return et::Success(size / 2);
+}
+
+using Errors = et::ErrorUnion<ParseError, IoError>;
+
+constexpr auto kEof = Errors(IoError::kEof);
+static_assert(kEof.Index() == 1, "");
+static_assert(kEof.Holds<IoError>(), "");
+static_assert(kEof.Get<IoError>() == IoError::kEof, "");
+static_assert(std::is_trivially_copyable<Errors>::value, "");
+static_assert(!std::is_trivially_copyable<et::ErrorUnion<int, Message>>::value,
+              "");
+
+static_assert(std::is_same<et::WidenedError<IoError, IoError>, IoError>::value,
+              "");
+static_assert(std::is_same<et::WidenedError<ParseError, IoError>,
+                           AppError>::value,
+              "");
+static_assert(std::is_same<et::WidenedError<Errors, IoError>, Errors>::value,
+              "");
+static_assert(
+    std::is_same<et::WidenedError<Errors, et::ErrorUnion<Message, IoError>>,
+                 et::ErrorUnion<ParseError, IoError, Message>>::value,
+    "");
+static_assert(std::is_same<et::WidenedError<Message, void>, Message>::value,
+              "");
+
+}  // namespace
+
+TEST_CASE("ErrorUnion holds one of its alternatives", "[and_then]") {
+  auto error = et::ErrorUnion<int, Message>(Message{"a long message, on heap"});
+  CHECK(error.Index() == 1);
+  CHECK(error.Holds<Message>());
+  CHECK(error.Get<Message>().text == "a long message, on heap");
+  CHECK_THROWS_AS(error.Get<int>(), et::BadEitherAccess);
+
+  auto const copy = error;
+  error = 7;
+  CHECK(error.Get<int>() == 7);
+  CHECK(copy.Get<Message>().text == "a long message, on heap");
+  CHECK(copy != error);
+  error = copy;
+  CHECK(copy == error);
+
+  // widening a subset maps the alternative
+  auto const wide = et::ErrorUnion<IoError, int, Message>(std::move(error));
+  CHECK(wide.Get<Message>().text == "a long message, on heap");
+
+  auto os = std::ostringstream();
+  os << Errors(IoError::kClosed) << ", " << Errors(ParseError::kNotANumber);
+  CHECK(os.str() == "io 3, not a number");
+}
+
+TEST_CASE("AndThen widens errors along a chain", "[and_then]") {
+  auto const parse_only = [](std::string const& text) {
+    return Parse(text).AndThen(Read);
+  };
+  STATIC_REQUIRE(std::is_same<decltype(parse_only("")),
+                              et::Either<std::int64_t, AppError>>::value);
+  CHECK(parse_only("x").Error().code == 1);
+  CHECK(parse_only("0").Error().code == 2);
+  CHECK(parse_only("4").Success() == 40);
+
+  auto const chain = [](std::string const& text) {
+    return Parse(text)
+        .AndThen([](int fd) {
+          return Read(fd).AndThen(
+              [](std::int64_t size) -> et::Either<std::int64_t, Errors> {
+                return et::Success(size);
+              });
+        })
+        .AndThen(Name);
+  };
+  using Expected =
+      et::Either<std::string, et::ErrorUnion<ParseError, IoError, Message>>;
+  STATIC_REQUIRE(std::is_same<decltype(chain("")), Expected>::value);
+
+  CHECK(chain("12").Success() == "120 bytes");
+  CHECK(chain("abc").Error().Get<ParseError>() == ParseError::kNotANumber);
+  CHECK(chain("0").Error().Get<IoError>() == IoError::kEof);
+  CHECK(chain("101").Error().Get<Message>().text == "too large: 1010");
+
+  // a step that cannot fail keeps the error type
+  auto const halved = Read(8).AndThen(Half);
+  STATIC_REQUIRE(std::is_same<decltype(halved),
+                              et::Either<std::int64_t, IoError> const>::value);
+  CHECK(halved.Success() == 40);
+}
+
+TEST_CASE("AndThen moves payloads and skips failed steps", "[and_then]") {
+  using Tracked = counting::Tracked<struct AndThenTag>;
+  Tracked::Reset();
+  auto calls = 0;
+  {
+    auto const result =
+        et::Either<Tracked, IoError>(et::Success(Tracked(3)))
+            .AndThen([&calls](Tracked&& tracked)
+                         -> et::Either<Tracked, ParseError> {
+              ++calls;
+              return et::Success(std::move(tracked));
+            })
+            .AndThen([&calls](Tracked const& tracked)
+                         -> et::Either<int, ParseError> {
+              ++calls;
+              return et::Error(tracked.Value() == 3 ? ParseError::kNotANumber
+                                                    : ParseError{});
+            })
+            .AndThen([&calls](int) -> et::Either<int, Message> {
+              ++calls;
+              return et::Success(0);
+            });
+    CHECK(result.Error().Get<ParseError>() == ParseError::kNotANumber);
+  }
+  CHECK(calls == 2);
+  CHECK(Tracked::Stats().Copies() == 0);
+  auto const empty = et::Either<int, IoError>();
+  CHECK_THROWS_AS(empty.AndThen(Read), et::BadEitherAccess);
+}
@@ -0,0 +1,132 @@
+# Compares the codegen of the snippet object against a snapshot:
+#
+#   cmake -DOBJDUMP=<objdump> -DOBJECT=<snippets.o> -DSNAPSHOT=<file>
+#         [-DUPDATE=ON] -P check.cmake
+#
+# Every et_asm_* function (its .cold part included) is reduced to counts of
+# instructions, conditional branches, calls and calls to __cxa_throw. A count
+# above the snapshot fails; UPDATE=ON rewrites the snapshot instead.
+
+cmake_minimum_required(VERSION 3.17)
+
+foreach (var OBJDUMP OBJECT SNAPSHOT)
+  if (NOT DEFINED ${var})
+    message(FATAL_ERROR "[et::asm] ${var} not set")
+  endif ()
+endforeach ()
+
+execute_process(
+  COMMAND ${OBJDUMP} -dr --no-show-raw-insn ${OBJECT}
+  OUTPUT_VARIABLE disassembly
+  RESULT_VARIABLE result
+)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "[et::asm] ${OBJDUMP} failed on ${OBJECT}")
+endif ()
+
+string(REPLACE ";" "," disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(metrics instructions branches calls throws)
+set(functions "")
+set(function "")
+set(after_call FALSE)
+
+foreach (line IN LISTS lines)
+  if (line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_.]+)>:$")
+    string(REGEX REPLACE "\\.cold$" "" function "${CMAKE_MATCH_1}")
+    if (NOT function MATCHES "^et_asm_")
+      set(function "")
+    elseif (NOT function IN_LIST functions)
+      list(APPEND functions ${function})
+      foreach (metric IN LISTS metrics)
+        set(${function}_${metric} 0)
+      endforeach ()
+    endif ()
+    set(after_call FALSE)
+  elseif (function AND line MATCHES "^ +[0-9a-f]+:\t([a-z0-9]+)")
+    set(op ${CMAKE_MATCH_1})
+    # alignment padding between functions
+    if (op MATCHES "^(nop|xchg|data16|cs)")
+      continue()
+    endif ()
+    math(EXPR ${function}_instructions "${${function}_instructions} + 1")
+    set(after_call FALSE)
+    if (op MATCHES "^call")
+      math(EXPR ${function}_calls "${${function}_calls} + 1")
+      set(after_call TRUE)
+    elseif (op MATCHES "^j" AND NOT op MATCHES "^jmp")
+      math(EXPR ${function}_branches "${${function}_branches} + 1")
+    endif ()
+  elseif (function AND after_call AND line MATCHES "R_[A-Z0-9_]+\t([A-Za-z0-9_]+)")
+    if (CMAKE_MATCH_1 STREQUAL "__cxa_throw")
+      math(EXPR ${function}_throws "${${function}_throws} + 1")
+    endif ()
+    set(after_call FALSE)
+  endif ()
+endforeach ()
+
+if (NOT functions)
+  message(FATAL_ERROR "[et::asm] no et_asm_* functions in ${OBJECT}")
+endif ()
+
+if (UPDATE)
+  set(content "# function instructions branches calls throws\n")
+  list(SORT functions)
+  foreach (function IN LISTS functions)
+    string(APPEND content "${function}")
+    foreach (metric IN LISTS metrics)
+      string(APPEND content " ${${function}_${metric}}")
+    endforeach ()
+    string(APPEND content "\n")
+  endforeach ()
+  file(WRITE ${SNAPSHOT} "${content}")
+  message(STATUS "[et::asm] wrote ${SNAPSHOT}")
+  return()
+endif ()
+
+if (NOT EXISTS ${SNAPSHOT})
+  message(STATUS "[et::asm] no snapshot for this compiler: ${SNAPSHOT}")
+  return()
+endif ()
+
+file(STRINGS ${SNAPSHOT} entries REGEX "^et_asm_")
+set(failures "")
+set(checked "")
+foreach (entry IN LISTS entries)
+  string(REPLACE " " ";" fields "${entry}")
+  list(GET fields 0 function)
+  list(APPEND checked ${function})
+  if (NOT function IN_LIST functions)
+    list(APPEND failures "${function}: missing from the object")
+    continue()
+  endif ()
+  set(index 1)
+  foreach (metric IN LISTS metrics)
+    list(GET fields ${index} expected)
+    set(actual ${${function}_${metric}})
+    if (actual GREATER expected)
+      list(APPEND failures "${function}: ${metric} ${actual} > ${expected}")
+    elseif (actual LESS expected)
+      message(STATUS "[et::asm] ${function}: ${metric} improved "
+                     "${expected} -> ${actual}, consider updating")
+    endif ()
+    math(EXPR index "${index} + 1")
+  endforeach ()
+endforeach ()
+
+foreach (function IN LISTS functions)
+  if (NOT function IN_LIST checked)
+    list(APPEND failures "${function}: not in the snapshot")
+  endif ()
+endforeach ()
+
+if (failures)
+  list(JOIN failures "\n  " report)
+  message(FATAL_ERROR "[et::asm] codegen regressed against ${SNAPSHOT}:\n"
+                      "  ${report}\n"
+                      "rebuild et_ASM_SNAPSHOT if the change is intended")
+endif ()
+
+list(LENGTH functions count)
+message(STATUS "[et::asm] ${count} snippets match ${SNAPSHOT}")
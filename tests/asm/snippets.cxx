@@ -0,0 +1,58 @@
+// Hot paths whose -O2 codegen is pinned by the snapshots in snapshots/, one
+// file per compiler, major version and architecture. The functions have C
+// linkage so objdump shows stable, readable names; add a snippet here and
+// build et_ASM_SNAPSHOT to record it.
+
+#include <cstdint>
+
+#include "et/either.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wreturn-type-c-linkage"
+#endif
+
+using Result = et::Either<std::int32_t, std::int32_t>;
+using Wide = et::Either<std::int64_t, std::int32_t>;
+
+extern "C" {
+
+// a load and a compare, no branch
+auto et_asm_is_success(Result const& e) -> bool { return e.IsSuccess(); }
+
+// the only call is the cold throw
+auto et_asm_success(Result const& e) -> std::int32_t { return e.Success(); }
+
+// checked access folds the throw away
+auto et_asm_success_checked(Result const& e) -> std::int32_t {
+  return e ? e.Success() : 0;
+}
+
+// factories and conversions build the result in registers
+auto et_asm_make_success(std::int32_t const value) -> Result {
+  return et::Success(value);
+}
+
+auto et_asm_make_error(std::int32_t const value) -> Result {
+  return et::Error(value);
+}
+
+// early return of the error, the usual propagation pattern
+auto et_asm_propagate(Result const e) -> Wide {
+  if (!e) {
+    return et::Error(e.Error());
+  }
+  return et::Success(std::int64_t(e.Success()) * 2);
+}
+
+// trivially copyable payloads copy as plain words
+void et_asm_copy(Wide const& from, Wide& to) { to = from; }
+
+void et_asm_assign_success(Wide& to, std::int64_t const value) {
+  to = et::Success(value);
+}
+
+auto et_asm_equal(Result const& lhs, Result const& rhs) -> bool {
+  return lhs == rhs;
+}
+
+}  // extern "C"
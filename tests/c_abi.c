@@ -0,0 +1,35 @@
+/* C callers of et/c_abi.h, compiled as C and linked into the tests */
+
+#include "et/c_abi.h"
+
+#include <errno.h>
+#include <stddef.h>
+
+et_result_i64 et_c_abi_parse(char const* text) {
+  et_result_i64 result;
+  int64_t value = 0;
+  if (text == NULL || *text == '\0') {
+    result.state = ET_C_ERROR;
+    result.value.error = EINVAL;
+    return result;
+  }
+  for (; *text != '\0'; ++text) {
+    if (*text < '0' || *text > '9') {
+      result.state = ET_C_ERROR;
+      result.value.error = EINVAL;
+      return result;
+    }
+    value = value * 10 + (*text - '0');
+  }
+  result.state = ET_C_SUCCESS;
+  result.value.success = value;
+  return result;
+}
+
+int64_t et_c_abi_value_or(et_result_i64 result, int64_t fallback) {
+  return result.state == ET_C_SUCCESS ? result.value.success : fallback;
+}
+
+size_t et_c_abi_sizeof_i64(void) { return sizeof(et_result_i64); }
+
+size_t et_c_abi_offsetof_i64(void) { return offsetof(et_result_i64, value); }
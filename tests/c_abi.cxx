@@ -0,0 +1,125 @@
+#include "et/c_abi.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "catch2/catch_test_macros.hpp"
+
+extern "C" {
+et_result_i64 et_c_abi_parse(char const* text);
+std::int64_t et_c_abi_value_or(et_result_i64 result, std::int64_t fallback);
+std::size_t et_c_abi_sizeof_i64(void);
+std::size_t et_c_abi_offsetof_i64(void);
+}
+
+namespace {
+
+enum class Status : std::int32_t { kBusy = 16, kTimedOut = 110 };
+
+// a wrapper crossing as its field, and one without a CRepr
+struct Code {
+  std::int32_t value;
+};
+
+struct Unmapped {
+  std::int32_t value;
+};
+
+ET_C_EITHER(ResultStatus, double, int32_t);
+ET_C_EITHER(ResultCode, uint64_t, int32_t);
+ET_C_EITHER(ResultNarrow, int64_t, int8_t);
+
+}  // namespace
+
+namespace et {
+
+template <>
+struct CRepr<Code> {
+  using type = std::int32_t;
+};
+
+}  // namespace et
+
+namespace {
+
+using et::detail::CLayoutMatches;
+
+static_assert(CLayoutMatches<et_result_i32, std::int32_t, std::int32_t>::value,
+              "");
+static_assert(CLayoutMatches<et_result_i64, std::int64_t, std::int32_t>::value,
+              "");
+static_assert(
+    CLayoutMatches<et_result_u64, std::uint64_t, std::int32_t>::value, "");
+static_assert(CLayoutMatches<et_result_f64, double, std::int32_t>::value, "");
+static_assert(CLayoutMatches<et_result_ptr, void*, std::int32_t>::value, "");
+static_assert(CLayoutMatches<ResultStatus, double, Status>::value, "");
+static_assert(CLayoutMatches<ResultNarrow, std::int64_t, std::int8_t>::value,
+              "");
+static_assert(CLayoutMatches<ResultCode, std::uint64_t, Code>::value, "");
+
+// mismatched payload types, sizes or unmapped wrappers never match
+static_assert(
+    !CLayoutMatches<et_result_i64, std::uint64_t, std::int32_t>::value, "");
+static_assert(!CLayoutMatches<et_result_i64, std::int64_t, std::int64_t>::value,
+              "");
+static_assert(!CLayoutMatches<et_result_i32, std::int64_t, std::int32_t>::value,
+              "");
+static_assert(!CLayoutMatches<ResultCode, std::uint64_t, Unmapped>::value,
+              "");
+
+// small results travel in registers on both sides
+static_assert(sizeof(et_result_i64) == 16, "");
+static_assert(std::is_trivially_copyable<et_result_i64>::value, "");
+
+}  // namespace
+
+TEST_CASE("C ABI structs match the C compiler's layout", "[c_abi]") {
+  CHECK(et_c_abi_sizeof_i64() == sizeof(et::Either<std::int64_t, int>));
+  CHECK(et_c_abi_offsetof_i64() == offsetof(et_result_i64, value));
+}
+
+TEST_CASE("C ABI round trips Either through C", "[c_abi]") {
+  using Et = et::Either<std::int64_t, std::int32_t>;
+
+  auto const parsed = et::FromC<std::int64_t, std::int32_t>(
+      et_c_abi_parse("9007199254740993"));
+  REQUIRE(parsed.IsSuccess());
+  CHECK(parsed.Success() == 9007199254740993);
+  CHECK(et::FromC<std::int64_t, std::int32_t>(et_c_abi_parse("12a")) ==
+        Et(et::Error(EINVAL)));
+
+  auto const success = Et(et::Success(std::int64_t(-7)));
+  CHECK(et_c_abi_value_or(et::ToC<et_result_i64>(success), 0) == -7);
+  CHECK(et_c_abi_value_or(et::ToC<et_result_i64>(Et(et::Error(EIO))), 5) == 5);
+
+  auto const c = et::ToC<et_result_i64>(Et(et::Error(ENOSPC)));
+  CHECK(c.state == ET_C_ERROR);
+  CHECK(c.value.error == ENOSPC);
+}
+
+TEST_CASE("C ABI maps enums and wrappers by their representation",
+          "[c_abi]") {
+  using Et = et::Either<double, Status>;
+  auto const c = et::ToC<ResultStatus>(Et(et::Error(Status::kTimedOut)));
+  CHECK(c.state == ET_C_ERROR);
+  CHECK(c.value.error == 110);
+  CHECK(et::FromC<double, Status>(c).Error() == Status::kTimedOut);
+
+  auto const code = et::ToC<ResultCode>(
+      et::Either<std::uint64_t, Code>(et::Error(Code{42})));
+  CHECK(code.value.error == 42);
+  CHECK((et::FromC<std::uint64_t, Code>(code).Error().value == 42));
+}
+
+TEST_CASE("C ABI reads unknown states as empty", "[c_abi]") {
+  auto c = et_result_i32();
+  std::memset(&c, 0x5A, sizeof(c));
+  CHECK(et::FromC<std::int32_t, std::int32_t>(c).IsEmpty());
+  c.state = ET_C_EMPTY;
+  CHECK(et::FromC<std::int32_t, std::int32_t>(c).IsEmpty());
+  c.state = ET_C_SUCCESS;
+  c.value.success = 3;
+  CHECK(et::FromC<std::int32_t, std::int32_t>(c).Success() == 3);
+}
@@ -0,0 +1,146 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/either.hpp"
+
+// everything below is checked by the compiler; the test cases only repeat a
+// few checks at run time so the same code paths are covered by sanitizers
+
+namespace {
+
+enum class DecodeError : std::uint8_t { kNotHex, kOddLength };
+
+std::ostream& operator<<(std::ostream& os, DecodeError const err) {
+  return os << (err == DecodeError::kNotHex ? "not hex" : "odd length");
+}
+
+using Nibble = et::Either<std::uint8_t, DecodeError>;
+
+constexpr auto DecodeHex(unsigned char const c) -> Nibble {
+  if (c >= '0' && c <= '9') {
+    return et::Success(static_cast<std::uint8_t>(c - '0'));
+  }
+  if (c >= 'a' && c <= 'f') {
+    return et::Success(static_cast<std::uint8_t>(c - 'a' + 10));
+  }
+  if (c >= 'A' && c <= 'F') {
+    return et::Success(static_cast<std::uint8_t>(c - 'A' + 10));
+  }
+  return et::Error(DecodeError::kNotHex);
+}
+
+template <std::size_t... Is>
+constexpr auto MakeHexTable(std::index_sequence<Is...>)
+    -> std::array<Nibble, sizeof...(Is)> {
+  return {{DecodeHex(static_cast<unsigned char>(Is))...}};
+}
+
+constexpr auto kHexTable = MakeHexTable(std::make_index_sequence<256>());
+
+static_assert(std::is_trivially_copyable<Nibble>::value, "");
+static_assert(kHexTable.size() == 256, "");
+static_assert(kHexTable['0'].Success() == 0, "");
+static_assert(kHexTable['9'].Success() == 9, "");
+static_assert(kHexTable['f'].Success() == 15, "");
+static_assert(kHexTable['g'].IsError(), "");
+static_assert(kHexTable['g'].Error() == DecodeError::kNotHex, "");
+static_assert(kHexTable['a'] == kHexTable['A'], "");
+static_assert(kHexTable['a'] != kHexTable['b'], "");
+static_assert(kHexTable['x'] == kHexTable['\0'], "");
+
+// decodes two hex digits per byte through the table above
+template <std::size_t N>
+constexpr auto DecodeByte(char const (&text)[N], std::size_t const i)
+    -> Nibble {
+  if (2 * i + 1 >= N - 1) {
+    return et::Error(DecodeError::kOddLength);
+  }
+  auto const hi = kHexTable[static_cast<unsigned char>(text[2 * i])];
+  auto const lo = kHexTable[static_cast<unsigned char>(text[2 * i + 1])];
+  if (!hi) {
+    return hi;
+  }
+  if (!lo) {
+    return lo;
+  }
+  return et::Success(static_cast<std::uint8_t>(hi.Success() << 4U |
+                                               lo.Success()));
+}
+
+template <std::size_t N, std::size_t... Is>
+constexpr auto DecodeBytes(char const (&text)[N], std::index_sequence<Is...>)
+    -> std::array<Nibble, sizeof...(Is)> {
+  return {{DecodeByte(text, Is)...}};
+}
+
+constexpr char kText[] = "c0ffeeZZ1";
+constexpr auto kBytes = DecodeBytes(kText, std::make_index_sequence<5>());
+
+static_assert(kBytes[0].Success() == 0xc0, "");
+static_assert(kBytes[1].Success() == 0xff, "");
+static_assert(kBytes[2].Success() == 0xee, "");
+static_assert(kBytes[3].Error() == DecodeError::kNotHex, "");
+static_assert(kBytes[4].Error() == DecodeError::kOddLength, "");
+
+// copy, move, conversion assignment and mutable access in a constant
+// expression
+constexpr auto Reassign() -> bool {
+  auto e = Nibble(et::Success(std::uint8_t(1)));
+  auto copy = e;
+  e = et::Error(DecodeError::kNotHex);
+  auto const still_success = copy.IsSuccess() && copy.Success() == 1;
+  copy = e;
+  auto moved = std::move(copy);
+  moved = et::Success(std::uint8_t(2));
+  moved.Success() += 1;
+  auto const error = et::Error(DecodeError::kOddLength);
+  e = error;
+  return still_success && copy.IsError() && moved.Success() == 3 &&
+         e.Error() == DecodeError::kOddLength;
+}
+
+static_assert(Reassign(), "");
+
+constexpr auto CountErrors() -> std::size_t {
+  auto errors = std::size_t(0);
+  for (auto i = std::size_t(0); i < kHexTable.size(); ++i) {
+    errors += kHexTable[i].IsError() ? 1 : 0;
+  }
+  return errors;
+}
+
+static_assert(CountErrors() == 256 - 22, "");
+
+// a preallocated buffer of empty slots filled in later
+constexpr auto FillSlots() -> bool {
+  Nibble slots[3];
+  auto const all_empty =
+      slots[0].IsEmpty() && slots[1].IsEmpty() && slots[2].IsEmpty();
+  slots[2] = DecodeHex('c');
+  slots[0] = DecodeHex('z');
+  return all_empty && slots[0].IsError() && slots[1] == Nibble(et::empty) &&
+         slots[2].Success() == 12;
+}
+
+static_assert(FillSlots(), "");
+
+}  // namespace
+
+TEST_CASE("constexpr hex table matches run time decoding",
+          "[either][constexpr]") {
+  for (auto i = std::size_t(0); i < kHexTable.size(); ++i) {
+    REQUIRE(kHexTable[i] == DecodeHex(static_cast<unsigned char>(i)));
+  }
+}
+
+TEST_CASE("constexpr assignment matches run time assignment",
+          "[either][constexpr]") {
+  REQUIRE(Reassign());
+  REQUIRE(FillSlots());
+  REQUIRE(DecodeBytes(kText, std::make_index_sequence<5>()) == kBytes);
+}
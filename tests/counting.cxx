@@ -0,0 +1,373 @@
+#include "counting.hpp"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/either.hpp"
+
+namespace {
+
+thread_local std::size_t news = 0;
+thread_local std::size_t deletes = 0;
+
+auto TryAllocate(std::size_t const size) noexcept -> void* {
+  ++news;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+auto Allocate(std::size_t const size) -> void* {
+  if (auto* const ptr = TryAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void Deallocate(void* const ptr) noexcept {
+  if (ptr != nullptr) {
+    ++deletes;
+    std::free(ptr);
+  }
+}
+
+#if defined(__cpp_aligned_new)
+auto TryAllocate(std::size_t const size,
+                 std::align_val_t const alignment) noexcept -> void* {
+  ++news;
+  auto* ptr = static_cast<void*>(nullptr);
+  auto const align =
+      std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+  return ::posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0 ? ptr
+                                                                 : nullptr;
+}
+
+auto Allocate(std::size_t const size, std::align_val_t const alignment)
+    -> void* {
+  if (auto* const ptr = TryAllocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+#endif
+
+}  // namespace
+
+// every replaceable form, so that no allocation bypasses the counters and no
+// pointer is freed by a different allocator than the one it came from (which
+// AddressSanitizer reports as alloc-dealloc-mismatch)
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  return TryAllocate(size);
+}
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+  return TryAllocate(size);
+}
+void operator delete(void* ptr) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+
+#if defined(__cpp_aligned_new)
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   std::nothrow_t const&) noexcept {
+  return TryAllocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     std::nothrow_t const&) noexcept {
+  return TryAllocate(size, alignment);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+void operator delete(void* ptr, std::align_val_t,
+                     std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t,
+                       std::nothrow_t const&) noexcept {
+  Deallocate(ptr);
+}
+#endif
+
+auto counting::ThreadAllocations() noexcept -> Allocations {
+  return Allocations{news, deletes};
+}
+
+namespace {
+
+using S = counting::Tracked<struct SuccessTag>;
+using E = counting::Tracked<struct ErrorTag>;
+using Result = et::Either<S, E>;
+using counting::Calls;
+
+void ResetCalls() {
+  S::Reset();
+  E::Reset();
+}
+
+// Calls{value_ctor, copy_ctor, move_ctor, copy_assign, move_assign, dtor}
+auto const kNone = Calls{0, 0, 0, 0, 0, 0};
+
+auto MakeResult(int const value) -> Result {
+  return et::Success(S(value));
+}
+
+auto Load() -> et::Either<std::string, int> {
+  return et::Success(std::string(64, 'x'));
+}
+
+}  // namespace
+
+TEST_CASE("factories copy or move their payload once", "[counting][factory]") {
+  auto const s = S(1);
+  auto e = E(2);
+
+  ResetCalls();
+  auto const copied = et::Success(s);
+  CHECK(S::Stats() == (Calls{0, 1, 0, 0, 0, 0}));
+
+  ResetCalls();
+  auto const moved = et::Error(std::move(e));
+  CHECK(E::Stats() == (Calls{0, 0, 1, 0, 0, 0}));
+
+  ResetCalls();
+  auto const temporary = et::Success(S(3));
+  CHECK(S::Stats() == (Calls{1, 0, 1, 0, 0, 1}));
+  CHECK(E::Stats() == kNone);
+}
+
+TEST_CASE("conversion constructors copy or move once", "[counting][ctor]") {
+  auto ok = et::Success(S(1));
+  auto err = et::Error(E(2));
+
+  ResetCalls();
+  auto const from_ok = Result(ok);
+  auto const from_err = Result(err);
+  CHECK(S::Stats() == (Calls{0, 1, 0, 0, 0, 0}));
+  CHECK(E::Stats() == (Calls{0, 1, 0, 0, 0, 0}));
+
+  ResetCalls();
+  auto const from_moved_ok = Result(std::move(ok));
+  auto const from_moved_err = Result(std::move(err));
+  CHECK(S::Stats() == (Calls{0, 0, 1, 0, 0, 0}));
+  CHECK(E::Stats() == (Calls{0, 0, 1, 0, 0, 0}));
+
+  // factory temporary straight into the result: one move per step
+  ResetCalls();
+  {
+    auto const direct = Result(et::Success(S(3)));
+    CHECK(S::Stats() == (Calls{1, 0, 2, 0, 0, 2}));
+  }
+  CHECK(S::Stats().dtor == 3);
+}
+
+TEST_CASE("copy and move constructors", "[counting][ctor]") {
+  auto source = Result(et::Error(E(1)));
+
+  ResetCalls();
+  auto const copy = source;
+  CHECK(E::Stats() == (Calls{0, 1, 0, 0, 0, 0}));
+
+  // the moved from payload is destroyed, leaving source empty
+  ResetCalls();
+  auto const moved = std::move(source);
+  CHECK(E::Stats() == (Calls{0, 0, 1, 0, 0, 1}));
+  CHECK(S::Stats() == kNone);
+  CHECK_FALSE(source.IsError());
+}
+
+TEST_CASE("copy and move assignment", "[counting][assign]") {
+  auto success = Result(et::Success(S(1)));
+  auto other = Result(et::Success(S(2)));
+  auto error = Result(et::Error(E(3)));
+
+  SECTION("same state assigns the payload") {
+    ResetCalls();
+    other = success;
+    CHECK(S::Stats() == (Calls{0, 0, 0, 1, 0, 0}));
+
+    ResetCalls();
+    other = std::move(success);
+    CHECK(S::Stats() == (Calls{0, 0, 0, 0, 1, 1}));
+  }
+
+  SECTION("state change destroys and constructs") {
+    ResetCalls();
+    error = success;
+    CHECK(S::Stats() == (Calls{0, 1, 0, 0, 0, 0}));
+    CHECK(E::Stats() == (Calls{0, 0, 0, 0, 0, 1}));
+
+    ResetCalls();
+    other = Result(et::Error(E(4)));
+    CHECK(S::Stats() == (Calls{0, 0, 0, 0, 0, 1}));
+    CHECK(E::Stats() == (Calls{1, 0, 3, 0, 0, 3}));
+  }
+
+  SECTION("self assignment does nothing") {
+    auto& self = success;
+    ResetCalls();
+    success = self;
+    success = std::move(self);
+    CHECK(S::Stats() == kNone);
+    CHECK(success.Success().Value() == 1);
+  }
+}
+
+TEST_CASE("conversion assignment", "[counting][assign]") {
+  auto ok = et::Success(S(5));
+  auto err = et::Error(E(6));
+  auto result = Result(et::Success(S(1)));
+
+  SECTION("same state assigns in place") {
+    ResetCalls();
+    result = ok;
+    CHECK(S::Stats() == (Calls{0, 0, 0, 1, 0, 0}));
+
+    ResetCalls();
+    result = std::move(ok);
+    CHECK(S::Stats() == (Calls{0, 0, 0, 0, 1, 0}));
+    CHECK(result.Success().Value() == 5);
+  }
+
+  SECTION("state change goes through one temporary") {
+    ResetCalls();
+    result = err;
+    CHECK(S::Stats() == (Calls{0, 0, 0, 0, 0, 1}));
+    CHECK(E::Stats() == (Calls{0, 1, 1, 0, 0, 1}));
+
+    ResetCalls();
+    result = std::move(ok);
+    CHECK(S::Stats() == (Calls{0, 0, 2, 0, 0, 1}));
+    CHECK(E::Stats() == (Calls{0, 0, 0, 0, 0, 1}));
+    CHECK(result.Success().Value() == 5);
+  }
+}
+
+TEST_CASE("accessors never copy", "[counting][access]") {
+  auto result = Result(et::Success(S(1)));
+  auto const& const_result = result;
+  auto ok = et::Success(S(2));
+  auto err = et::Error(E(3));
+
+  ResetCalls();
+  CHECK(result.IsSuccess());
+  CHECK_FALSE(result.IsError());
+  CHECK(static_cast<bool>(result));
+  CHECK(result.Success().Value() == 1);
+  CHECK(const_result.Success().Value() == 1);
+  CHECK(std::move(const_result).Success().Value() == 1);
+  CHECK(ok.Success().Value() == 2);
+  CHECK(err.Error().Value() == 3);
+  CHECK(S::Stats() == kNone);
+  CHECK(E::Stats() == kNone);
+
+  // binding the rvalue reference moves nothing, initializing a value once
+  ResetCalls();
+  S&& ref = std::move(result).Success();
+  CHECK(S::Stats() == kNone);
+  auto const value = std::move(result).Success();
+  auto const from_ok = std::move(ok).Success();
+  auto const from_err = std::move(err).Error();
+  auto const from_const = std::move(const_result).Success();
+  CHECK(S::Stats() == (Calls{0, 1, 2, 0, 0, 0}));
+  CHECK(E::Stats() == (Calls{0, 0, 1, 0, 0, 0}));
+  CHECK(ref.Value() == -1);
+  CHECK(result.IsSuccess());
+}
+
+TEST_CASE("comparison, hashing and printing never copy",
+          "[counting][access]") {
+  auto const lhs = Result(et::Success(S(1)));
+  auto const rhs = Result(et::Error(E(1)));
+  auto const ok = et::Success(S(1));
+  auto const err = et::Error(E(1));
+  auto os = std::ostringstream();
+
+  ResetCalls();
+  CHECK(lhs == lhs);
+  CHECK(lhs != rhs);
+  CHECK(ok == ok);
+  CHECK(err == err);
+  CHECK(std::hash<Result>()(lhs) != std::hash<Result>()(rhs));
+  os << lhs << rhs << ok << err;
+  CHECK(S::Stats() == kNone);
+  CHECK(E::Stats() == kNone);
+  CHECK(os.str() == "1111");
+}
+
+TEST_CASE("success path allocates once and only moves",
+          "[counting][allocation]") {
+  auto const before = counting::ThreadAllocations();
+  auto const value = Load().Success();
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news - before.news == 1);
+  CHECK(value.size() == 64);
+
+  // factory, conversion to the result and extraction: one move each
+  ResetCalls();
+  auto const tracked = MakeResult(7).Success();
+  CHECK(S::Stats() == (Calls{1, 0, 3, 0, 0, 3}));
+  CHECK(tracked.Value() == 7);
+
+  // none of the either.hpp types allocate on their own
+  auto const start = counting::ThreadAllocations();
+  {
+    auto result = MakeResult(8);
+    auto copy = result;
+    copy = et::Error(E(9));
+    result = std::move(copy);
+  }
+  auto const end = counting::ThreadAllocations();
+  CHECK(end.news == start.news);
+  CHECK(end.deletes == start.deletes);
+}
+
+TEST_CASE("every operator new form is counted", "[counting][allocation]") {
+  // direct calls, which unlike new expressions the compiler may not elide
+  auto const before = counting::ThreadAllocations();
+  ::operator delete(::operator new(8, std::nothrow));
+  ::operator delete[](::operator new[](8, std::nothrow));
+  ::operator delete(::operator new(8, std::nothrow), std::nothrow);
+#if defined(__cpp_aligned_new)
+  auto const align = std::align_val_t(64);
+  ::operator delete(::operator new(64, align), align);
+  ::operator delete[](::operator new[](128, align), 128, align);
+  ::operator delete(::operator new(64, align, std::nothrow), align,
+                    std::nothrow);
+#endif
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news - before.news == after.deletes - before.deletes);
+#if defined(__cpp_aligned_new)
+  CHECK(after.news - before.news == 6);
+#else
+  CHECK(after.news - before.news == 3);
+#endif
+}
@@ -0,0 +1,123 @@
+#ifndef ET_TESTS_COUNTING_HPP_
+#define ET_TESTS_COUNTING_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+// Test utility counting heap allocations and payload special member calls.
+// The global operator new / delete replacements counting allocations live in
+// counting.cxx; the counters are per thread, so threads spawned by other
+// tests never leak into a measurement.
+namespace counting {
+
+struct Allocations {
+  std::size_t news;
+  std::size_t deletes;
+};
+
+// allocations made by the calling thread since it started
+auto ThreadAllocations() noexcept -> Allocations;
+
+// special member calls of one Tracked<Tag> instantiation
+struct Calls {
+  std::size_t value_ctor;
+  std::size_t copy_ctor;
+  std::size_t move_ctor;
+  std::size_t copy_assign;
+  std::size_t move_assign;
+  std::size_t dtor;
+
+  auto Copies() const noexcept -> std::size_t {
+    return copy_ctor + copy_assign;
+  }
+
+  auto Moves() const noexcept -> std::size_t {
+    return move_ctor + move_assign;
+  }
+};
+
+inline bool operator==(Calls const& lhs, Calls const& rhs) noexcept {
+  return lhs.value_ctor == rhs.value_ctor && lhs.copy_ctor == rhs.copy_ctor &&
+         lhs.move_ctor == rhs.move_ctor && lhs.copy_assign == rhs.copy_assign &&
+         lhs.move_assign == rhs.move_assign && lhs.dtor == rhs.dtor;
+}
+
+inline std::ostream& operator<<(std::ostream& os, Calls const& calls) {
+  return os << "{value " << calls.value_ctor << ", copy " << calls.copy_ctor
+            << ", move " << calls.move_ctor << ", copy assign "
+            << calls.copy_assign << ", move assign " << calls.move_assign
+            << ", dtor " << calls.dtor << "}";
+}
+
+// payload recording every special member call in a per thread Calls; a
+// distinct Tag gives success and error payloads separate counters
+template <class Tag>
+class Tracked {
+ public:
+  static auto Stats() noexcept -> Calls& {
+    static thread_local auto calls = Calls{0, 0, 0, 0, 0, 0};
+    return calls;
+  }
+
+  static void Reset() noexcept { Stats() = Calls{0, 0, 0, 0, 0, 0}; }
+
+  explicit Tracked(int value) noexcept : value_(value) {
+    ++Stats().value_ctor;
+  }
+
+  Tracked(Tracked const& that) noexcept : value_(that.value_) {
+    ++Stats().copy_ctor;
+  }
+
+  Tracked(Tracked&& that) noexcept : value_(that.value_) {
+    that.value_ = -1;
+    ++Stats().move_ctor;
+  }
+
+  Tracked& operator=(Tracked const& that) noexcept {
+    value_ = that.value_;
+    ++Stats().copy_assign;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& that) noexcept {
+    value_ = that.value_;
+    that.value_ = -1;
+    ++Stats().move_assign;
+    return *this;
+  }
+
+  ~Tracked() { ++Stats().dtor; }
+
+  auto Value() const noexcept -> int { return value_; }
+
+ private:
+  int value_;
+};
+
+template <class Tag>
+bool operator==(Tracked<Tag> const& lhs, Tracked<Tag> const& rhs) noexcept {
+  return lhs.Value() == rhs.Value();
+}
+
+template <class Tag>
+std::ostream& operator<<(std::ostream& os, Tracked<Tag> const& tracked) {
+  return os << tracked.Value();
+}
+
+}  // namespace counting
+
+namespace std {
+
+template <class Tag>
+struct hash<::counting::Tracked<Tag>> {
+  auto operator()(::counting::Tracked<Tag> const& tracked) const noexcept
+      -> std::size_t {
+    return std::hash<int>()(tracked.Value());
+  }
+};
+
+}  // namespace std
+
+#endif  // ET_TESTS_COUNTING_HPP_
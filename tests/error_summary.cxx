@@ -0,0 +1,178 @@
+#include "et/error_summary.hpp"
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+
+namespace {
+
+using Outcome = et::Either<std::uint32_t, std::string>;
+using Summary = et::ErrorSummary<std::string, 4, 256>;
+
+auto ErrorName(std::uint32_t const kind) -> std::string {
+  return "error kind " + std::to_string(kind);
+}
+
+// errors 0..kinds-1 with frequency falling as 1 / (kind + 1)
+auto ZipfStream(std::size_t const length, std::uint32_t const kinds,
+                std::uint32_t const seed) -> std::vector<Outcome> {
+  auto weights = std::vector<double>();
+  for (auto kind = 0U; kind < kinds; ++kind) {
+    weights.push_back(1.0 / (kind + 1.0));
+  }
+  auto engine = std::mt19937(seed);
+  auto pick = std::discrete_distribution<std::uint32_t>(weights.begin(),
+                                                        weights.end());
+  auto stream = std::vector<Outcome>();
+  for (auto i = std::size_t(0); i < length; ++i) {
+    if (i % 4 == 0) {
+      stream.emplace_back(et::Success(static_cast<std::uint32_t>(i)));
+    } else {
+      stream.emplace_back(et::Error(ErrorName(pick(engine))));
+    }
+  }
+  return stream;
+}
+
+auto TrueCounts(std::vector<Outcome> const& stream, std::uint32_t const kinds)
+    -> std::vector<std::uint64_t> {
+  auto counts = std::vector<std::uint64_t>(kinds, 0);
+  for (auto const& outcome : stream) {
+    for (auto kind = 0U; outcome.IsError() && kind < kinds; ++kind) {
+      counts[kind] += outcome.Error() == ErrorName(kind) ? 1 : 0;
+    }
+  }
+  return counts;
+}
+
+}  // namespace
+
+TEST_CASE("ErrorSummary counts exactly below capacity", "[error_summary]") {
+  auto summary = Summary();
+  summary.Add(Outcome(et::Success(1U)));
+  summary.Add(et::Success(2U));
+  summary.Add(et::Error(std::string("timeout")));
+  summary.Add(Outcome(et::Error(std::string("refused"))));
+  summary.Add(Outcome(et::Error(std::string("timeout"))));
+  summary.Add(Outcome());
+
+  CHECK(summary.Successes() == 2);
+  CHECK(summary.Errors() == 3);
+  CHECK(summary.Total() == 5);
+  CHECK(summary.Estimate("timeout") == 2);
+  CHECK(summary.Estimate("refused") == 1);
+
+  auto const top = summary.TopK();
+  REQUIRE(top.size() == 2);
+  CHECK(top[0].error == "timeout");
+  CHECK(top[0].count == 2);
+  CHECK(top[0].overestimate == 0);
+
+  auto os = std::ostringstream();
+  os << top[1];
+  CHECK(os.str() == "refused: 1 (overestimate 0)");
+}
+
+TEST_CASE("ErrorSummary bounds heavy errors in fixed memory",
+          "[error_summary]") {
+  constexpr auto kKinds = 200U;
+  auto const stream = ZipfStream(40000, kKinds, 7);
+  auto const truth = TrueCounts(stream, kKinds);
+
+  auto summary = et::ErrorSummary<std::string, 16, 256>();
+  auto const before = counting::ThreadAllocations();
+  for (auto const& outcome : stream) {
+    summary.Add(outcome);
+  }
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news == before.news);
+
+  auto underestimates = 0;
+  for (auto kind = 0U; kind < kKinds; ++kind) {
+    underestimates += summary.Estimate(ErrorName(kind)) < truth[kind] ? 1 : 0;
+  }
+  CHECK(underestimates == 0);
+
+  // every error above Errors() / kTopK is in the table, within its bounds
+  REQUIRE(truth[0] > summary.Errors() / 16);
+  auto const top = summary.TopK();
+  REQUIRE(top.size() == 16);
+  CHECK(top[0].error == ErrorName(0));
+  auto out_of_bounds = 0;
+  for (auto const& heavy : top) {
+    for (auto kind = 0U; kind < kKinds; ++kind) {
+      if (heavy.error == ErrorName(kind)) {
+        out_of_bounds += heavy.count >= truth[kind] &&
+                                 heavy.count - heavy.overestimate <= truth[kind]
+                             ? 0
+                             : 1;
+      }
+    }
+  }
+  CHECK(out_of_bounds == 0);
+}
+
+TEST_CASE("ErrorSummary per thread instances merge", "[error_summary]") {
+  constexpr auto kThreads = 4U;
+  constexpr auto kKinds = 10U;
+  auto streams = std::vector<std::vector<Outcome>>();
+  for (auto t = 0U; t < kThreads; ++t) {
+    streams.push_back(ZipfStream(10000, kKinds, t + 1));
+  }
+
+  auto summaries = std::vector<Summary>(kThreads);
+  auto threads = std::vector<std::thread>();
+  for (auto t = std::size_t(0); t < kThreads; ++t) {
+    threads.emplace_back([&summaries, &streams, t] {
+      for (auto const& outcome : streams[t]) {
+        summaries[t].Add(outcome);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto whole = Summary();
+  auto merged = Summary();
+  for (auto t = std::size_t(0); t < kThreads; ++t) {
+    for (auto const& outcome : streams[t]) {
+      whole.Add(outcome);
+    }
+    merged.Merge(summaries[t]);
+  }
+
+  CHECK(merged.Successes() == whole.Successes());
+  CHECK(merged.Errors() == whole.Errors());
+  auto sketch_mismatches = 0;
+  for (auto kind = 0U; kind < kKinds; ++kind) {
+    sketch_mismatches +=
+        merged.Estimate(ErrorName(kind)) == whole.Estimate(ErrorName(kind))
+            ? 0
+            : 1;
+  }
+  CHECK(sketch_mismatches == 0);
+
+  auto all = std::vector<Outcome>();
+  for (auto const& stream : streams) {
+    all.insert(all.end(), stream.begin(), stream.end());
+  }
+  auto const truth = TrueCounts(all, kKinds);
+  auto const top = merged.TopK();
+  REQUIRE(top.size() == 4);
+  CHECK(top[0].error == ErrorName(0));
+  for (auto const& heavy : top) {
+    for (auto kind = 0U; kind < kKinds; ++kind) {
+      if (heavy.error == ErrorName(kind)) {
+        CHECK(heavy.count >= truth[kind]);
+        CHECK(heavy.count - heavy.overestimate <= truth[kind]);
+      }
+    }
+  }
+}
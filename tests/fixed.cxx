@@ -0,0 +1,154 @@
+#include "et/fixed.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+
+namespace {
+
+using Kind = et::CapacityError::Kind;
+using Item = counting::Tracked<struct FixedTag>;
+using Owners = et::FixedVector<std::unique_ptr<int>, 2>;
+using OwnerRing = et::FixedRing<std::unique_ptr<int>, 2>;
+
+// the containers are exactly as copyable and movable as their elements
+static_assert(!std::is_copy_constructible<Owners>::value, "");
+static_assert(!std::is_copy_assignable<Owners>::value, "");
+static_assert(std::is_nothrow_move_constructible<Owners>::value, "");
+static_assert(std::is_nothrow_move_assignable<Owners>::value, "");
+static_assert(!std::is_copy_constructible<OwnerRing>::value, "");
+static_assert(std::is_move_assignable<OwnerRing>::value, "");
+static_assert(!std::is_copy_constructible<et::Either<Owners, int>>::value,
+              "");
+static_assert(std::is_move_constructible<et::Either<Owners, int>>::value, "");
+static_assert(
+    !std::is_move_constructible<et::FixedVector<std::mutex, 2>>::value, "");
+static_assert(std::is_copy_constructible<et::FixedRing<std::string, 2>>::value,
+              "");
+
+}  // namespace
+
+TEST_CASE("FixedVector fills up to its capacity", "[fixed]") {
+  auto const before = counting::ThreadAllocations();
+  auto vector = et::FixedVector<std::int32_t, 3>();
+  CHECK(vector.IsEmpty());
+  for (auto i = 0; i < 3; ++i) {
+    auto const pushed = vector.TryPushBack(i * 10);
+    REQUIRE(pushed.IsSuccess());
+    CHECK(*pushed.Success() == i * 10);
+  }
+  CHECK(vector.IsFull());
+  auto const full = vector.TryPushBack(30);
+  REQUIRE(full.IsError());
+  CHECK(full.Error() == et::CapacityError(Kind::kFull, 3));
+  CHECK(vector.Size() == 3);
+  CHECK(vector[2] == 20);
+
+  auto sum = 0;
+  for (auto const element : vector) {
+    sum += element;
+  }
+  CHECK(sum == 30);
+
+  CHECK(vector.TryPopBack().Success() == 20);
+  CHECK(vector.TryPopBack().Success() == 10);
+  CHECK(vector.TryPopBack().Success() == 0);
+  CHECK(vector.TryPopBack().Error().GetKind() == Kind::kEmpty);
+  CHECK(counting::ThreadAllocations().news == before.news);
+
+  // an empty vector iterates over nothing and copies as empty
+  CHECK(vector.begin() == vector.end());
+  auto const copy = vector;
+  CHECK(copy.begin() == copy.end());
+  CHECK(copy.IsEmpty());
+}
+
+TEST_CASE("FixedVector constructs and destroys in place", "[fixed]") {
+  Item::Reset();
+  {
+    auto vector = et::FixedVector<Item, 4>();
+    REQUIRE(vector.TryEmplaceBack(1).IsSuccess());
+    REQUIRE(vector.TryEmplaceBack(2).IsSuccess());
+    CHECK(Item::Stats().value_ctor == 2);
+    CHECK(Item::Stats().Copies() == 0);
+
+    auto copy = vector;
+    CHECK(copy[1].Value() == 2);
+    auto moved = std::move(copy);
+    CHECK(moved.Size() == 2);
+    CHECK(moved[0].Value() == 1);
+
+    vector.Clear();
+    CHECK(vector.IsEmpty());
+  }
+  // 2 emplaced, 2 copied, 2 moved
+  CHECK(Item::Stats().dtor == 6);
+
+  auto strings = et::FixedVector<std::unique_ptr<std::string>, 2>();
+  REQUIRE(strings.TryPushBack(std::make_unique<std::string>("a")).IsSuccess());
+  auto popped = strings.TryPopBack();
+  REQUIRE(popped.IsSuccess());
+  CHECK(*popped.Success() == "a");
+
+  auto owners = Owners();
+  REQUIRE(owners.TryPushBack(std::make_unique<int>(1)).IsSuccess());
+  REQUIRE(owners.TryPushBack(std::make_unique<int>(2)).IsSuccess());
+  auto either = et::Either<Owners, int>(et::Success(std::move(owners)));
+  auto const moved = std::move(either).Success();
+  auto sum = 0;
+  for (auto const& owner : moved) {
+    sum += *owner;
+  }
+  CHECK(sum == 3);
+
+  auto ring = OwnerRing();
+  REQUIRE(ring.TryPush(std::make_unique<int>(1)).IsSuccess());
+  REQUIRE(ring.TryPush(std::make_unique<int>(2)).IsSuccess());
+  CHECK(*ring.TryPop().Success() == 1);
+  REQUIRE(ring.TryPush(std::make_unique<int>(3)).IsSuccess());
+  auto other = OwnerRing();
+  other = std::move(ring);
+  CHECK(*other[0] == 2);
+  CHECK(*other[1] == 3);
+}
+
+TEST_CASE("FixedRing is first in first out across the wrap", "[fixed]") {
+  auto ring = et::FixedRing<std::string, 3>();
+  CHECK(ring.TryPop().Error() == et::CapacityError(Kind::kEmpty, 3));
+  for (auto round = 0; round < 5; ++round) {
+    auto const first = std::to_string(round);
+    REQUIRE(ring.TryPush(first).IsSuccess());
+    REQUIRE(ring.TryEmplace(2, 'x').IsSuccess());
+    CHECK(ring.Size() == 2);
+    CHECK(ring[0] == first);
+    CHECK(ring.TryPop().Success() == first);
+    CHECK(ring.TryPop().Success() == "xx");
+  }
+
+  REQUIRE(ring.TryPush("a").IsSuccess());
+  REQUIRE(ring.TryPush("b").IsSuccess());
+  auto const third = ring.TryPush("c");
+  REQUIRE(third.IsSuccess());
+  CHECK(*third.Success() == "c");
+  CHECK(ring.IsFull());
+  CHECK(ring.TryPush("d").Error().GetKind() == Kind::kFull);
+
+  auto const copy = ring;
+  CHECK(ring.TryPop().Success() == "a");
+  REQUIRE(ring.TryPush("d").IsSuccess());
+  CHECK(ring[2] == "d");
+  CHECK(copy.Size() == 3);
+  CHECK(copy[0] == "a");
+}
+
+TEST_CASE("CapacityError prints its kind", "[fixed]") {
+  auto os = std::ostringstream();
+  os << et::CapacityError(Kind::kFull, 8);
+  CHECK(os.str() == "full at capacity 8");
+}
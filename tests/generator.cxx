@@ -0,0 +1,299 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+#include "et/generator.hpp"
+
+namespace {
+
+using Value = et::Either<std::int32_t, std::int32_t>;
+
+// yields 0, 1, -2 (an error), 3 and counts how far the producer got
+template <et::ErrorPolicy Policy>
+auto Numbers(std::int32_t& produced) {
+  return et::MakeGenerator<Value, Policy>([&produced](auto& yield) {
+    for (auto i = 0; i < 4; ++i) {
+      ++produced;
+      auto const value =
+          i == 2 ? Value(et::Error(-i)) : Value(et::Success(i));
+      if (!yield(value)) {
+        return;
+      }
+    }
+  });
+}
+
+}  // namespace
+
+TEST_CASE("CallbackGenerator stops after the first error",
+          "[generator][CallbackGenerator]") {
+  auto produced = 0;
+  auto seen = std::vector<Value>();
+  Numbers<et::ErrorPolicy::kStop>(produced).ForEach(
+      [&seen](Value&& value) { seen.push_back(value); });
+
+  REQUIRE(seen.size() == 3);
+  CHECK(seen[1].Success() == 1);
+  CHECK(seen[2].Error() == -2);
+  CHECK(produced == 3);
+}
+
+TEST_CASE("CallbackGenerator continues past errors",
+          "[generator][CallbackGenerator]") {
+  auto produced = 0;
+  auto errors = 0;
+  auto values = 0;
+  Numbers<et::ErrorPolicy::kContinue>(produced).ForEach(
+      [&](Value const& value) {
+        ++values;
+        errors += value.IsError() ? 1 : 0;
+      });
+
+  CHECK(values == 4);
+  CHECK(errors == 1);
+  CHECK(produced == 4);
+}
+
+TEST_CASE("CallbackGenerator consumers can stop early",
+          "[generator][CallbackGenerator]") {
+  auto produced = 0;
+  auto values = 0;
+  Numbers<et::ErrorPolicy::kContinue>(produced).ForEach([&](Value&&) {
+    return ++values < 2;
+  });
+
+  CHECK(values == 2);
+  CHECK(produced == 2);
+}
+
+TEST_CASE("Collect returns the successes or the first error",
+          "[generator][Collect]") {
+  auto produced = 0;
+  auto const failed =
+      et::Collect(Numbers<et::ErrorPolicy::kContinue>(produced));
+  REQUIRE(failed.IsError());
+  CHECK(failed.Error() == -2);
+  CHECK(produced == 3);
+
+  auto const values = std::vector<Value>{Value(et::Success(4)),
+                                         Value(et::Success(5))};
+  auto const collected = et::Collect(values);
+  REQUIRE(collected.IsSuccess());
+  CHECK(collected.Success() == std::vector<std::int32_t>{4, 5});
+  CHECK(values[0].Success() == 4);
+}
+
+#if ET_HAS_COROUTINES
+
+namespace {
+
+template <et::ErrorPolicy Policy>
+auto Coroutine(std::int32_t& produced) -> et::Generator<Value, Policy> {
+  for (auto i = 0; i < 4; ++i) {
+    ++produced;
+    if (i == 2) {
+      co_yield et::Error(-i);
+    } else {
+      co_yield et::Success(i);
+    }
+  }
+}
+
+using Text = et::Either<std::string, std::string>;
+
+// long enough that a moved from string is left empty
+auto Texts() -> et::Generator<Text> {
+  co_yield et::Success(std::string(32, 'a'));
+  co_yield et::Error(std::string(32, 'e'));
+  co_yield et::Success(std::string(32, 'b'));
+  co_yield et::Success(std::string(32, 'c'));
+}
+
+auto Throwing() -> et::Generator<Value> {
+  co_yield et::Success(1);
+  throw std::runtime_error("[Throwing] error: gave up");
+}
+
+// bump allocator over a fixed buffer, deallocation is a no-op
+class Arena {
+ public:
+  auto Allocate(std::size_t const size, std::size_t const align) -> void* {
+    auto const offset = (used_ + align - 1) / align * align;
+    if (offset + size > sizeof(buffer_)) {
+      throw std::bad_alloc();
+    }
+    used_ = offset + size;
+    return buffer_ + offset;
+  }
+
+  auto Used() const noexcept -> std::size_t { return used_; }
+
+ private:
+  alignas(std::max_align_t) unsigned char buffer_[4096];
+  std::size_t used_ = 0;
+};
+
+template <class T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+  template <class U>
+  ArenaAllocator(ArenaAllocator<U> const& that) noexcept
+      : arena_(that.arena_) {}
+
+  auto allocate(std::size_t const n) -> T* {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  template <class U>
+  bool operator==(ArenaAllocator<U> const& that) const noexcept {
+    return arena_ == that.arena_;
+  }
+
+ private:
+  template <class U>
+  friend class ArenaAllocator;
+
+  Arena* arena_;
+};
+
+using ArenaGenerator =
+    et::Generator<Value, et::ErrorPolicy::kStop, ArenaAllocator<std::byte>>;
+
+auto Counted(std::allocator_arg_t, ArenaAllocator<std::byte> const&,
+             std::int32_t const count) -> ArenaGenerator {
+  for (auto i = 0; i < count; ++i) {
+    co_yield et::Success(i);
+  }
+}
+
+// as many parameters after the allocator as the plain, non template
+// operator new overloads of the promise take
+auto Summed(std::allocator_arg_t, ArenaAllocator<std::byte> const&,
+            std::string const prefix, std::int32_t const a,
+            std::int32_t const b, std::int32_t const c, std::int32_t const d,
+            std::int32_t const e) -> ArenaGenerator {
+  co_yield et::Success(static_cast<std::int32_t>(prefix.size()) + a + b + c +
+                       d + e);
+}
+
+struct Source {
+  auto Values(std::allocator_arg_t, ArenaAllocator<std::byte> const&) const
+      -> ArenaGenerator {
+    co_yield et::Success(first);
+    co_yield et::Error(-1);
+    co_yield et::Success(first + 1);
+  }
+
+  std::int32_t first;
+};
+
+}  // namespace
+
+TEST_CASE("Generator works with range-for", "[generator][Generator]") {
+  auto produced = 0;
+  auto seen = std::vector<Value>();
+  for (auto&& value : Coroutine<et::ErrorPolicy::kStop>(produced)) {
+    seen.push_back(std::move(value));
+  }
+  REQUIRE(seen.size() == 3);
+  CHECK(seen[2].Error() == -2);
+  CHECK(produced == 3);
+
+  produced = 0;
+  auto errors = 0;
+  for (auto const& value : Coroutine<et::ErrorPolicy::kContinue>(produced)) {
+    errors += value.IsError() ? 1 : 0;
+  }
+  CHECK(errors == 1);
+  CHECK(produced == 4);
+}
+
+TEST_CASE("Generator feeds Collect and ForEach", "[generator][Generator]") {
+  auto produced = 0;
+  auto const failed =
+      et::Collect(Coroutine<et::ErrorPolicy::kContinue>(produced));
+  REQUIRE(failed.IsError());
+  CHECK(failed.Error() == -2);
+  CHECK(produced == 3);
+
+  auto arena = Arena();
+  auto const collected =
+      et::Collect(Counted(std::allocator_arg,
+                          ArenaAllocator<std::byte>(arena), 3));
+  REQUIRE(collected.IsSuccess());
+  CHECK(collected.Success() == std::vector<std::int32_t>{0, 1, 2});
+
+  auto values = 0;
+  Coroutine<et::ErrorPolicy::kContinue>(produced).ForEach(
+      [&values](Value&&) { return ++values < 3; });
+  CHECK(values == 3);
+}
+
+TEST_CASE("Generator stops after an error the consumer moved out",
+          "[generator][Generator]") {
+  auto seen = std::vector<Text>();
+  for (auto& value : Texts()) {
+    seen.push_back(std::move(value));
+  }
+  REQUIRE(seen.size() == 2);
+  CHECK(seen[1].Error() == std::string(32, 'e'));
+
+  auto consumed = std::vector<Text>();
+  Texts().ForEach([&consumed](Text&& value) {
+    consumed.push_back(std::move(value));
+  });
+  REQUIRE(consumed.size() == 2);
+  CHECK(consumed[1].IsError());
+}
+
+TEST_CASE("Generator rethrows from the coroutine", "[generator][Generator]") {
+  auto generator = Throwing();
+  auto it = generator.begin();
+  CHECK(it->Success() == 1);
+  CHECK_THROWS_AS(++it, std::runtime_error);
+}
+
+TEST_CASE("Generator frames come from the allocator",
+          "[generator][Generator][allocation]") {
+  auto arena = Arena();
+  auto const before = counting::ThreadAllocations();
+  auto sum = 0;
+  {
+    auto generator =
+        Counted(std::allocator_arg, ArenaAllocator<std::byte>(arena), 10);
+    for (auto const& value : generator) {
+      sum += value.Success();
+    }
+    auto const source = Source{7};
+    auto values = source.Values(std::allocator_arg,
+                                ArenaAllocator<std::byte>(arena));
+    auto it = values.begin();
+    CHECK(it->Success() == 7);
+    ++it;
+    CHECK(it->Error() == -1);
+    ++it;
+    CHECK(it == values.end());
+
+    auto summed = Summed(std::allocator_arg, ArenaAllocator<std::byte>(arena),
+                         "ab", 1, 2, 3, 4, 5);
+    CHECK(summed.begin()->Success() == 17);
+  }
+  auto const after = counting::ThreadAllocations();
+
+  CHECK(sum == 45);
+  CHECK(arena.Used() > 0);
+  CHECK(after.news == before.news);
+}
+
+#endif  // ET_HAS_COROUTINES
@@ -0,0 +1,149 @@
+#include "et/init_graph.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+using Graph = et::InitGraph<std::string>;
+using Outcome = et::Either<int, std::string>;
+
+// records the order nodes ran in
+class Trace {
+ public:
+  auto Step(std::string name) -> std::function<Outcome()> {
+    return [this, name] {
+      std::lock_guard<std::mutex> const lock(mutex_);
+      order_.push_back(name);
+      return Outcome(et::Success(0));
+    };
+  }
+
+  auto Order() -> std::vector<std::string> {
+    std::lock_guard<std::mutex> const lock(mutex_);
+    return order_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::string> order_;
+};
+
+auto IndexOf(std::vector<std::string> const& order, std::string const& name)
+    -> std::size_t {
+  for (auto i = std::size_t(0); i < order.size(); ++i) {
+    if (order[i] == name) {
+      return i;
+    }
+  }
+  return order.size();
+}
+
+}  // namespace
+
+TEST_CASE("InitGraph runs nodes after their dependencies", "[init_graph]") {
+  Trace trace;
+  auto graph = Graph();
+  auto const config = graph.Add("config", trace.Step("config"));
+  auto const log = graph.Add("log", trace.Step("log"), {config});
+  auto const db = graph.Add("db", trace.Step("db"), {config});
+  graph.Add("cache", trace.Step("cache"), {db, log});
+  graph.Add("metrics", [] { return et::Either<int, void>(et::Success(1)); });
+  CHECK(graph.Size() == 5);
+
+  auto const run = graph.Run(4);
+  REQUIRE(run.IsSuccess());
+  auto const order = trace.Order();
+  REQUIRE(order.size() == 4);
+  CHECK(IndexOf(order, "config") == 0);
+  CHECK(IndexOf(order, "cache") == 3);
+
+  auto const& report = run.Success();
+  REQUIRE(report.nodes.size() == 5);
+  CHECK(report.nodes[3].name == "cache");
+  for (auto const& node : report.nodes) {
+    CHECK(node.state == et::InitState::kSucceeded);
+    CHECK(node.start + node.duration <= report.elapsed);
+  }
+  CHECK(report.nodes[3].start >=
+        report.nodes[2].start + report.nodes[2].duration);
+  CHECK(report.Slowest().size() == 5);
+}
+
+TEST_CASE("InitGraph runs independent nodes concurrently", "[init_graph]") {
+  // each node finishes only once both are running
+  std::atomic<int> running(0);
+  auto const rendezvous = [&running] {
+    running.fetch_add(1);
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (running.load() < 2) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return Outcome(et::Error(std::string("alone")));
+      }
+      std::this_thread::yield();
+    }
+    return Outcome(et::Success(0));
+  };
+  auto graph = Graph();
+  graph.Add("a", rendezvous);
+  graph.Add("b", rendezvous);
+  CHECK(graph.Run(2).IsSuccess());
+}
+
+TEST_CASE("InitGraph reports the failed dependency path", "[init_graph]") {
+  Trace trace;
+  auto graph = Graph();
+  auto const config = graph.Add("config", trace.Step("config"));
+  auto const other = graph.Add("other", trace.Step("other"));
+  auto const db = graph.Add(
+      "db", [] { return Outcome(et::Error(std::string("refused"))); },
+      {config, other});
+  graph.Add("cache", trace.Step("cache"), {db});
+  graph.Add("late", trace.Step("late"), {other});
+
+  // one thread: config, other, then db and late in the order they got ready
+  auto const run = graph.Run(1);
+  REQUIRE(run.IsError());
+  auto const& failure = run.Error();
+  CHECK(failure.error == "refused");
+  CHECK(failure.path == std::vector<std::string>{"other", "db"});
+  CHECK(trace.Order() == std::vector<std::string>{"config", "other"});
+
+  auto const& nodes = failure.report.nodes;
+  CHECK(nodes[2].state == et::InitState::kFailed);
+  CHECK(nodes[3].state == et::InitState::kCancelled);
+  CHECK(nodes[4].state == et::InitState::kCancelled);
+  CHECK(nodes[4].duration == std::chrono::steady_clock::duration::zero());
+  CHECK(failure.report.Slowest().size() == 3);
+
+  auto os = std::ostringstream();
+  os << failure;
+  CHECK(os.str() == "init failed: refused in other -> db");
+}
+
+TEST_CASE("InitGraph cancels on a throwing node", "[init_graph]") {
+  Trace trace;
+  auto graph = Graph();
+  auto const boom = graph.Add("boom", []() -> Outcome {
+    throw std::runtime_error("boom");
+  });
+  graph.Add("after", trace.Step("after"), {boom});
+  CHECK_THROWS_AS(graph.Run(2), std::runtime_error);
+  CHECK(trace.Order().empty());
+
+  // nothing to run is a success
+  auto empty = Graph();
+  auto const run = empty.Run();
+  REQUIRE(run.IsSuccess());
+  CHECK(run.Success().nodes.empty());
+}
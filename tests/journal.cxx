@@ -0,0 +1,244 @@
+#include "et/journal.hpp"
+
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+enum class Stage : std::uint8_t { kParse = 3, kValidate = 4 };
+
+// empty temporary file, removed on scope exit
+class TempPath {
+ public:
+  TempPath() {
+    char path[] = "/tmp/et_journal_testXXXXXX";
+    auto const fd = ::mkstemp(path);
+    REQUIRE(fd != -1);
+    ::close(fd);
+    path_ = path;
+  }
+
+  TempPath(TempPath const&) = delete;
+  TempPath& operator=(TempPath const&) = delete;
+
+  ~TempPath() { ::unlink(path_.c_str()); }
+
+  auto Get() const noexcept -> char const* { return path_.c_str(); }
+
+ private:
+  std::string path_;
+};
+
+auto ReadBack(char const* path) -> std::vector<et::JournalRecord> {
+  auto reader = et::JournalReader::Open(path);
+  REQUIRE(reader.IsSuccess());
+  return reader.Success().Records();
+}
+
+}  // namespace
+
+TEST_CASE("Journal encodes outcomes", "[journal]") {
+  TempPath const path;
+  {
+    auto journal = et::Journal::Open(path.Get(), 64);
+    REQUIRE(journal.IsSuccess());
+    CHECK(journal.Success().Capacity() == 64);
+
+    auto& log = journal.Success();
+    log.Append(1, et::Either<std::int32_t, Stage>(et::Success(-2)));
+    log.Append(2, et::Either<std::int32_t, Stage>(et::Error(Stage::kParse)));
+    log.Append(3, et::Success(7U));
+    log.Append(4, et::Error(et::Errno(ENOENT)));
+    log.Append(5, true, 42);
+  }
+
+  auto const records = ReadBack(path.Get());
+  REQUIRE(records.size() == 5);
+  CHECK(records[0].site == 1);
+  CHECK_FALSE(records[0].error);
+  CHECK(records[0].payload == static_cast<std::uint64_t>(-2));
+  CHECK(records[1].error);
+  CHECK(records[1].payload == 3);
+  CHECK(records[2].payload == 7);
+  CHECK(records[3].payload == ENOENT);
+  CHECK(records[4].site == 5);
+  CHECK(records[4].payload == 42);
+  for (auto i = std::size_t(0); i < records.size(); ++i) {
+    CHECK(records[i].sequence == i);
+    CHECK(records[i].thread == records[0].thread);
+    CHECK(records[i].time_ns >= records[0].time_ns);
+  }
+}
+
+TEST_CASE("Journal keeps the last lap of the ring", "[journal]") {
+  TempPath const path;
+  auto journal = et::Journal::Open(path.Get(), 50);
+  REQUIRE(journal.IsSuccess());
+  REQUIRE(journal.Success().Capacity() == 64);
+  for (auto i = std::uint64_t(0); i < 100; ++i) {
+    journal.Success().Append(9, false, i);
+  }
+
+  auto reader = et::JournalReader::Open(path.Get());
+  REQUIRE(reader.IsSuccess());
+  // the second half of the last chunk is reserved but never written
+  CHECK(reader.Success().Appended() == 112);
+  auto const records = reader.Success().Records();
+  REQUIRE(records.size() == 52);
+  CHECK(records.front().payload == 48);
+  CHECK(records.back().payload == 99);
+}
+
+TEST_CASE("Journal reserves per thread without losing entries", "[journal]") {
+  constexpr auto kThreads = 4;
+  constexpr auto kAppends = std::uint64_t(2000);
+  TempPath const path;
+  auto journal = et::Journal::Open(path.Get(), 1 << 14);
+  REQUIRE(journal.IsSuccess());
+
+  auto threads = std::vector<std::thread>();
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&log = journal.Success(), t] {
+      for (auto i = std::uint64_t(0); i < kAppends; ++i) {
+        log.Append(static_cast<std::uint32_t>(t), i % 3 == 0, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto const records = ReadBack(path.Get());
+  REQUIRE(records.size() == kThreads * kAppends);
+  // each site is one thread, its payloads come out in order
+  auto next = std::vector<std::uint64_t>(kThreads, 0);
+  auto out_of_order = 0;
+  for (auto const& record : records) {
+    out_of_order += record.payload == next[record.site] ? 0 : 1;
+    next[record.site] = record.payload + 1;
+  }
+  CHECK(out_of_order == 0);
+}
+
+TEST_CASE("Journal is created once by concurrent openers", "[journal]") {
+  constexpr auto kOpeners = 8;
+  for (auto round = 0; round < 20; ++round) {
+    TempPath const path;
+    // each opener appends once right away; an opener initializing the file
+    // again would reset the head and the entries already written. Room for
+    // every opener's kChunk reservation, so the ring does not lap.
+    std::atomic<int> waiting(kOpeners);
+    auto openers = std::vector<std::thread>();
+    std::atomic<int> failed(0);
+    for (auto t = 0; t < kOpeners; ++t) {
+      openers.emplace_back([&, t] {
+        waiting.fetch_sub(1);
+        while (waiting.load() > 0) {
+          std::this_thread::yield();
+        }
+        auto journal =
+            et::Journal::Open(path.Get(), kOpeners * et::Journal::kChunk);
+        if (!journal) {
+          failed.fetch_add(1);
+          return;
+        }
+        journal.Success().Append(static_cast<std::uint32_t>(t), false, 1);
+      });
+    }
+    for (auto& opener : openers) {
+      opener.join();
+    }
+    REQUIRE(failed.load() == 0);
+    CHECK(ReadBack(path.Get()).size() == kOpeners);
+  }
+}
+
+TEST_CASE("Journal waits for the opener initializing the file",
+          "[journal]") {
+  TempPath const path;
+  // stands in for another process halfway through creating the journal
+  auto const holder = ::open(path.Get(), O_RDWR);
+  REQUIRE(holder != -1);
+  REQUIRE(::flock(holder, LOCK_EX) == 0);
+
+  std::atomic<bool> opened(false);
+  auto opener = std::thread([&path, &opened] {
+    auto journal = et::Journal::Open(path.Get(), 32);
+    opened.store(journal.IsSuccess());
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CHECK_FALSE(opened.load());
+
+  ::close(holder);
+  opener.join();
+  CHECK(opened.load());
+}
+
+TEST_CASE("Journal survives a killed process", "[journal]") {
+  TempPath const path;
+  auto const child = ::fork();
+  REQUIRE(child != -1);
+  if (child == 0) {
+    auto journal = et::Journal::Open(path.Get(), 256);
+    if (!journal) {
+      ::_exit(1);
+    }
+    for (auto i = std::uint64_t(0); i < 20; ++i) {
+      journal.Success().Append(11, i == 19, i);
+    }
+    ::raise(SIGKILL);
+  }
+
+  auto status = 0;
+  REQUIRE(::waitpid(child, &status, 0) == child);
+  REQUIRE(WIFSIGNALED(status));
+
+  auto const records = ReadBack(path.Get());
+  REQUIRE(records.size() == 20);
+  CHECK(records.back().error);
+  CHECK(records.back().payload == 19);
+}
+
+TEST_CASE("Journal reopens or rejects existing files", "[journal]") {
+  TempPath const path;
+  {
+    auto journal = et::Journal::Open(path.Get(), 32);
+    REQUIRE(journal.IsSuccess());
+    journal.Success().Append(1, false, 1);
+  }
+  {
+    auto journal = et::Journal::Open(path.Get(), 32);
+    REQUIRE(journal.IsSuccess());
+    journal.Success().Append(1, false, 2);
+  }
+  auto const records = ReadBack(path.Get());
+  REQUIRE(records.size() == 2);
+  CHECK(records[1].sequence == 16);
+
+  CHECK(et::Journal::Open(path.Get(), 64).Error().GetKind() ==
+        et::JournalError::Kind::kLayoutMismatch);
+
+  TempPath const other;
+  auto const fd = ::open(other.Get(), O_WRONLY);
+  REQUIRE(fd != -1);
+  auto const junk = std::string(4096, 'x');
+  REQUIRE(::write(fd, junk.data(), junk.size()) == 4096);
+  ::close(fd);
+  CHECK(et::JournalReader::Open(other.Get()).Error().GetKind() ==
+        et::JournalError::Kind::kBadMagic);
+  CHECK(et::JournalReader::Open("/nonexistent/et/journal").Error() ==
+        et::JournalError(et::Errno(ENOENT)));
+}
@@ -0,0 +1,137 @@
+#include "et/lane_either.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+using Ints = std::array<std::int32_t, 8>;
+using Lanes = et::LaneEither<Ints, std::uint8_t, std::string>;
+using Lane = Lanes::LaneType;
+
+auto Divide(Ints const& numerators, Ints const& divisors) -> Lanes {
+  auto zeros = std::uint8_t(0);
+  auto quotients = Ints();
+  for (auto i = std::size_t(0); i < 8; ++i) {
+    if (divisors[i] == 0) {
+      zeros = static_cast<std::uint8_t>(zeros | (1U << i));
+    } else {
+      quotients[i] = numerators[i] / divisors[i];
+    }
+  }
+  return Lanes(quotients, static_cast<std::uint8_t>(~zeros), "div by zero");
+}
+
+}  // namespace
+
+TEST_CASE("LaneEither lane traits", "[lane_either]") {
+  STATIC_REQUIRE(Lanes::kLanes == 8);
+  STATIC_REQUIRE(Lanes::kAllLanes == 0xFF);
+  STATIC_REQUIRE(std::is_same<Lanes::SuccessType, std::int32_t>::value);
+  STATIC_REQUIRE(
+      et::LaneEither<std::array<float, 16>, std::uint16_t, int>::kAllLanes ==
+      0xFFFF);
+}
+
+TEST_CASE("LaneEither masks and per lane access", "[lane_either]") {
+  auto const all = Lanes(Ints{1, 2, 3, 4, 5, 6, 7, 8});
+  CHECK(all.AllSuccess());
+  CHECK(all.ErrorMask() == 0);
+  CHECK(all.Success(7) == 8);
+  CHECK_THROWS_AS(all.Error(0), et::BadEitherAccess);
+  CHECK_FALSE(all.IsSuccess(8));
+
+  auto lanes =
+      Divide(Ints{8, 8, 8, 8, 8, 8, 8, 8}, Ints{1, 0, 2, 0, 4, 8, 0, 1});
+  CHECK(lanes.SuccessMask() == 0xB5);
+  CHECK(lanes.ErrorMask() == 0x4A);
+  CHECK_FALSE(lanes.AllSuccess());
+  CHECK(lanes.Success(2) == 4);
+  CHECK(lanes.Error(3) == "div by zero");
+  CHECK_THROWS_AS(lanes.Success(1), et::BadEitherAccess);
+
+  // errors stay attached to their lane when more lanes fail
+  lanes.Fail(0x03, "overflow");
+  CHECK(lanes.Error(0) == "overflow");
+  CHECK(lanes.Error(1) == "div by zero");
+  CHECK(lanes.Error(6) == "div by zero");
+  CHECK(lanes.SuccessMask() == 0xB4);
+}
+
+TEST_CASE("LaneEither converts to and from arrays of Either", "[lane_either]") {
+  auto const array = std::array<Lane, 8>{
+      {Lane(et::Success(1)), Lane(et::Error(std::string("a"))),
+       Lane(et::Success(3)), Lane(et::Success(4)),
+       Lane(et::Error(std::string("b"))), Lane(et::Success(6)),
+       Lane(et::Success(7)), Lane(et::Error(std::string("c")))}};
+
+  auto const lanes = Lanes(array);
+  CHECK(lanes.SuccessMask() == 0x6D);
+  CHECK(lanes.Error(4) == "b");
+  CHECK(lanes.Lane(5) == Lane(et::Success(6)));
+  CHECK(lanes.ToArray() == array);
+}
+
+TEST_CASE("LaneEither masked map, and then and select", "[lane_either]") {
+  auto const lanes = Divide(Ints{9, 9, 9, 9, 6, 9, 9, 9},
+                            Ints{1, 3, 0, 9, 3, 0, 1, 9});
+
+  auto const doubled = lanes.Map([](Ints const& values) {
+    auto result = std::array<std::int64_t, 8>();
+    for (auto i = std::size_t(0); i < 8; ++i) {
+      result[i] = std::int64_t(values[i]) * 2;
+    }
+    return result;
+  });
+  CHECK(doubled.SuccessMask() == lanes.SuccessMask());
+  CHECK(doubled.Success(1) == 6);
+  CHECK(doubled.Error(5) == "div by zero");
+
+  // a second kernel failing other lanes keeps the first error of each lane
+  auto const odd = lanes.AndThen([](Ints const& values) {
+    auto mask = std::uint8_t(0);
+    for (auto i = std::size_t(0); i < 8; ++i) {
+      mask = static_cast<std::uint8_t>(mask | ((values[i] % 2) << i));
+    }
+    return Lanes(values, mask, "even");
+  });
+  CHECK(odd.SuccessMask() == 0xCB);
+  CHECK(odd.Error(2) == "div by zero");
+  CHECK(odd.Error(4) == "even");
+  CHECK(odd.Error(5) == "div by zero");
+
+  CHECK(lanes.Select(Ints{-1, -2, -3, -4, -5, -6, -7, -8}) ==
+        (Ints{9, 3, -3, 1, 2, -6, 9, 1}));
+  CHECK(odd.ValueOr(0) == (Ints{9, 3, 0, 1, 0, 0, 9, 1}));
+
+  auto calls = 0;
+  auto const none = Lanes(Ints(), 0, "failed").AndThen([&calls](Ints const&) {
+    ++calls;
+    return Lanes(Ints());
+  });
+  CHECK(calls == 0);
+  CHECK(none.ErrorMask() == 0xFF);
+  CHECK(none.Error(7) == "failed");
+}
+
+#if defined(__GNUC__)
+
+TEST_CASE("LaneEither over compiler vector types", "[lane_either]") {
+  using Vec = std::int32_t __attribute__((vector_size(16)));
+  using VecLanes = et::LaneEither<Vec, std::uint8_t, int>;
+  STATIC_REQUIRE(VecLanes::kLanes == 4);
+
+  auto const lanes = VecLanes(Vec{1, 2, 3, 4}, 0x0B, -1);
+  auto const squared = lanes.Map([](Vec const& v) -> Vec { return v * v; });
+  CHECK(squared.Success(3) == 16);
+  CHECK(squared.Error(2) == -1);
+
+  auto const selected = squared.Select(Vec{0, 0, 0, 0});
+  CHECK(selected[0] == 1);
+  CHECK(selected[2] == 0);
+}
+
+#endif
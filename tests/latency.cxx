@@ -0,0 +1,110 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/latency.hpp"
+
+namespace {
+
+auto Check(std::int32_t value) -> et::Either<std::int32_t, std::int32_t> {
+  if (value < 0) {
+    return et::Error(value);
+  }
+  return et::Success(value);
+}
+
+}  // namespace
+
+TEST_CASE("LatencyHistogram buckets are contiguous and bounded",
+          "[latency][LatencyHistogram]") {
+  using H = et::LatencyHistogram;
+
+  for (auto i = std::size_t(0); i + 1 < H::kBuckets; ++i) {
+    REQUIRE(H::BucketOf(H::LowerBound(i)) == i);
+    REQUIRE(H::BucketOf(H::UpperBound(i)) == i);
+    REQUIRE(H::UpperBound(i) + 1 == H::LowerBound(i + 1));
+  }
+  CHECK(H::BucketOf(~std::uint64_t(0)) == H::kBuckets - 1);
+
+  // relative bucket width never exceeds 1 / kSubBuckets
+  for (auto i = H::kSubBuckets; i + 1 < H::kBuckets; ++i) {
+    auto const width = H::UpperBound(i) - H::LowerBound(i) + 1;
+    REQUIRE(width * H::kSubBuckets <= H::LowerBound(i));
+  }
+}
+
+TEST_CASE("LatencyHistogram percentiles", "[latency][LatencyHistogram]") {
+  auto h = et::LatencyHistogram();
+  CHECK(h.Percentile(0.5) == 0);
+
+  for (auto v = std::uint64_t(1); v <= 1000; ++v) {
+    h.Record(v);
+  }
+  CHECK(h.Count() == 1000);
+  CHECK(h.Sum() == 500500);
+  CHECK(h.Mean() == 500.5);
+
+  auto const p50 = h.Percentile(0.5);
+  CHECK(p50 >= 500);
+  CHECK(p50 < 500 + 500 / et::LatencyHistogram::kSubBuckets);
+  CHECK(h.Percentile(1.0) >= 1000);
+  CHECK(h.Percentile(0.0) == 1);
+
+  auto merged = et::LatencyHistogram();
+  merged.Merge(h);
+  merged.Merge(h);
+  CHECK(merged.Count() == 2000);
+  CHECK(merged.Percentile(0.5) == p50);
+}
+
+TEST_CASE("LatencyRecorder splits outcomes", "[latency][LatencyRecorder]") {
+  et::LatencyRecorder recorder;
+
+  for (auto i = 0; i < 100; ++i) {
+    auto const result = ET_TIMED(recorder, Check(i % 4 == 0 ? -i : i));
+    CHECK(result.IsError() == (i % 4 == 0 && i != 0));
+  }
+  recorder.Record(true, 1000);
+
+  auto const report = recorder.Snapshot();
+  CHECK(report.success.Count() == 77);
+  CHECK(report.error.Count() == 24);
+  CHECK(report.success.Sum() >= 1000);
+  CHECK(report.ns_per_tick > 0.0);
+
+  auto os = std::ostringstream();
+  os << report;
+  CHECK(os.str().find("success: count 77") == 0);
+  CHECK(os.str().find("error: count 24") != std::string::npos);
+}
+
+TEST_CASE("LatencyRecorder merges per thread shards",
+          "[latency][LatencyRecorder]") {
+  et::LatencyRecorder recorder;
+  auto const threads = std::size_t(8);
+  auto const calls = std::uint64_t(10000);
+
+  auto workers = std::vector<std::thread>();
+  for (auto t = std::size_t(0); t < threads; ++t) {
+    workers.emplace_back([&recorder, t] {
+      for (auto i = std::uint64_t(0); i < calls; ++i) {
+        recorder.Record(i % 2 == 0, t * 100 + i);
+      }
+    });
+  }
+  // snapshots race with the writers and only ever see partial counts
+  while (recorder.Snapshot().success.Count() < threads * calls / 4) {
+    std::this_thread::yield();
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  auto const report = recorder.Snapshot();
+  CHECK(report.success.Count() == threads * calls / 2);
+  CHECK(report.error.Count() == threads * calls / 2);
+}
@@ -0,0 +1,74 @@
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/mapped_file.hpp"
+
+namespace {
+
+auto WriteTempFile(std::string const& content) -> std::string {
+  char path[] = "/tmp/et_mapped_file_testXXXXXX";
+  auto const fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  REQUIRE(et::sys::Write(fd, content.data(), content.size()).IsSuccess());
+  ::close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("MappedFile maps file content", "[mapped_file][Open]") {
+  auto const content = std::string("first line\nsecond line\n");
+  auto const path = WriteTempFile(content);
+
+  auto file = et::MappedFile::Open(path);
+  ::unlink(path.c_str());
+
+  REQUIRE(file.IsSuccess());
+  auto const mapped = std::move(file).Success();
+  CHECK(mapped.Size() == content.size());
+  CHECK(std::string(mapped.begin(), mapped.end()) == content);
+  CHECK(mapped.Advise(et::MappedFile::Advice::kSequential).IsSuccess());
+  CHECK(mapped.Advise(et::MappedFile::Advice::kWillNeed).IsSuccess());
+#if __cplusplus >= 201703L
+  CHECK(mapped.View() == content);
+#endif
+}
+
+TEST_CASE("MappedFile maps empty file to empty view", "[mapped_file][Open]") {
+  auto const path = WriteTempFile("");
+
+  auto const file = et::MappedFile::Open(path);
+  ::unlink(path.c_str());
+
+  REQUIRE(file.IsSuccess());
+  CHECK(file.Success().Empty());
+  CHECK(file.Success().Data() == nullptr);
+}
+
+TEST_CASE("MappedFile reports missing file", "[mapped_file][Open]") {
+  auto const file = et::MappedFile::Open("/nonexistent/et/mapped_file");
+
+  REQUIRE(file.IsError());
+  CHECK(file.Error() == et::Errno(ENOENT));
+}
+
+TEST_CASE("MappedFile move transfers ownership", "[mapped_file][move]") {
+  auto const path = WriteTempFile("payload");
+
+  auto file = et::MappedFile::Open(path);
+  ::unlink(path.c_str());
+  REQUIRE(file.IsSuccess());
+
+  auto first = std::move(file).Success();
+  auto const data = first.Data();
+  auto second = std::move(first);
+
+  CHECK(first.Empty());
+  CHECK(second.Data() == data);
+  CHECK(second.Size() == 7);
+}
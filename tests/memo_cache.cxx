@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/memo_cache.hpp"
+
+namespace {
+
+using Cache = et::MemoCache<std::int32_t, std::string, std::int32_t>;
+
+auto Resolve(std::int32_t key) -> et::Either<std::string, std::int32_t> {
+  if (key < 0) {
+    return et::Error(key);
+  }
+  return et::Success(std::to_string(key));
+}
+
+}  // namespace
+
+TEST_CASE("MemoCache caches successes and errors", "[memo_cache][Get]") {
+  Cache cache;
+  auto calls = 0;
+  auto const resolve = [&calls](std::int32_t key) {
+    ++calls;
+    return Resolve(key);
+  };
+
+  CHECK(cache.Get(1, resolve).Success() == "1");
+  CHECK(cache.Get(1, resolve).Success() == "1");
+  CHECK(cache.Get(-1, resolve).Error() == -1);
+  CHECK(cache.Get(-1, resolve).Error() == -1);
+  CHECK(calls == 2);
+
+  auto const stats = cache.GetStats();
+  CHECK(stats.hits == 2);
+  CHECK(stats.negative_hits == 1);
+  CHECK(stats.misses == 2);
+  CHECK(cache.Size() == 2);
+}
+
+TEST_CASE("MemoCache applies separate ttl to errors", "[memo_cache][ttl]") {
+  auto options = Cache::Options();
+  options.error_ttl = std::chrono::milliseconds(1);
+  Cache cache(options);
+  auto calls = 0;
+  auto const resolve = [&calls](std::int32_t key) {
+    ++calls;
+    return Resolve(key);
+  };
+
+  cache.Get(-1, resolve);
+  cache.Get(2, resolve);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  cache.Get(-1, resolve);
+  cache.Get(2, resolve);
+
+  CHECK(calls == 3);
+  CHECK(cache.GetStats().expirations == 1);
+}
+
+TEST_CASE("MemoCache zero ttl disables negative caching", "[memo_cache][ttl]") {
+  auto options = Cache::Options();
+  options.error_ttl = Cache::Clock::duration::zero();
+  Cache cache(options);
+  auto calls = 0;
+  auto const resolve = [&calls](std::int32_t key) {
+    ++calls;
+    return Resolve(key);
+  };
+
+  cache.Get(-1, resolve);
+  cache.Get(-1, resolve);
+
+  CHECK(calls == 2);
+  CHECK(cache.Size() == 0);
+}
+
+TEST_CASE("MemoCache stays within capacity", "[memo_cache][eviction]") {
+  auto options = Cache::Options();
+  options.capacity = 8;
+  options.shards = 2;
+  Cache cache(options);
+
+  for (auto key = 0; key < 100; ++key) {
+    CHECK(cache.Get(key, Resolve).Success() == std::to_string(key));
+  }
+
+  CHECK(cache.Size() <= cache.Capacity());
+  CHECK(cache.GetStats().evictions >= 100 - cache.Capacity());
+}
+
+TEST_CASE("MemoCache coalesces concurrent misses", "[memo_cache][flight]") {
+  Cache cache;
+  std::atomic<std::int32_t> calls(0);
+  auto const slow = [&calls](std::int32_t key) {
+    ++calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return Resolve(key);
+  };
+
+  auto threads = std::vector<std::thread>();
+  auto results = std::vector<std::string>(8);
+  for (auto i = std::size_t(0); i < results.size(); ++i) {
+    threads.emplace_back(
+        [&, i] { results[i] = cache.Get(7, slow).Success(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(calls == 1);
+  for (auto const& result : results) {
+    CHECK(result == "7");
+  }
+  auto const stats = cache.GetStats();
+  CHECK(stats.misses == 1);
+  CHECK(stats.hits + stats.coalesced == results.size() - 1);
+}
@@ -0,0 +1,97 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/packed_either.hpp"
+
+namespace {
+
+enum class Errc : std::uint8_t { kNotFound = 1, kDenied = 2, kTimeout = 200 };
+
+struct IdOrErrc {
+  using SuccessType = std::uint32_t;
+  using ErrorType = Errc;
+  static constexpr unsigned kSuccessBits = 31;
+  static constexpr unsigned kErrorBits = 8;
+};
+
+struct OffsetOrCode {
+  using SuccessType = std::int64_t;
+  using ErrorType = std::int16_t;
+  static constexpr unsigned kSuccessBits = 40;
+  static constexpr unsigned kErrorBits = 12;
+};
+
+using PackedId = et::PackedEither<IdOrErrc>;
+using PackedOffset = et::PackedEither<OffsetOrCode>;
+
+}  // namespace
+
+TEST_CASE("PackedEither packs into a single word", "[packed_either][layout]") {
+  static_assert(sizeof(PackedId) == sizeof(std::uint32_t), "");
+  static_assert(sizeof(PackedOffset) == sizeof(std::uint64_t), "");
+  static_assert(std::is_trivially_copyable<PackedId>::value, "");
+  static_assert(std::is_trivially_copyable<PackedOffset>::value, "");
+
+  std::atomic<PackedId> slot(PackedId(et::Success(std::uint32_t(1))));
+  CHECK(slot.is_lock_free());
+
+  auto expected = slot.load();
+  CHECK(slot.compare_exchange_strong(expected,
+                                     PackedId(et::Error(Errc::kNotFound))));
+  CHECK(slot.load().Error() == Errc::kNotFound);
+  std::atomic<PackedOffset> wide(PackedOffset(et::Error(std::int16_t(1))));
+  CHECK(wide.is_lock_free());
+}
+
+TEST_CASE("PackedEither constexpr access", "[packed_either][constexpr]") {
+  constexpr auto id = PackedId(et::Success(std::uint32_t(0x7fffffff)));
+  constexpr auto err = PackedId(et::Error(Errc::kTimeout));
+
+  static_assert(id.IsSuccess() && !id.IsError(), "");
+  static_assert(id.Success() == 0x7fffffff, "");
+  static_assert(err.IsError() && !err, "");
+  static_assert(err.Error() == Errc::kTimeout, "");
+  static_assert(id != err, "");
+  static_assert(PackedId::FromBits(err.Bits()) == err, "");
+
+  CHECK_THROWS_AS(id.Error(), et::BadEitherAccess);
+  CHECK_THROWS_AS(err.Success(), et::BadEitherAccess);
+}
+
+TEST_CASE("PackedEither sign extends signed payloads",
+          "[packed_either][signed]") {
+  constexpr auto offset = PackedOffset(et::Success(std::int64_t(-12345678)));
+  constexpr auto code = PackedOffset(et::Error(std::int16_t(-2048)));
+
+  static_assert(offset.Success() == -12345678, "");
+  static_assert(code.Error() == -2048, "");
+
+  CHECK(PackedOffset(et::Success(std::int64_t(549755813887))).Success() ==
+        549755813887);
+}
+
+TEST_CASE("PackedEither rejects payloads wider than declared",
+          "[packed_either][range]") {
+  CHECK_THROWS_AS(PackedId(et::Success(std::uint32_t(0x80000000))),
+                  et::BadEitherAssign);
+  CHECK_THROWS_AS(PackedOffset(et::Error(std::int16_t(2048))),
+                  et::BadEitherAssign);
+  CHECK_THROWS_AS(PackedOffset(et::Success(std::int64_t(1) << 40)),
+                  et::BadEitherAssign);
+}
+
+TEST_CASE("PackedEither hashing and printing", "[packed_either][hash]") {
+  auto const id = PackedId(et::Success(std::uint32_t(42)));
+  auto const err = PackedId(et::Error(Errc::kDenied));
+
+  CHECK(std::hash<PackedId>()(id) ==
+        std::hash<PackedId>()(PackedId::FromBits(id.Bits())));
+
+  auto os = std::ostringstream();
+  os << id << ' ' << err;
+  CHECK(os.str() == "42 2");
+}
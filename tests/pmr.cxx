@@ -0,0 +1,152 @@
+#include "et/pmr.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+#include "et/either.hpp"
+
+namespace {
+
+template <class T, class = void>
+struct HasAllocatorType : std::false_type {};
+
+template <class T>
+struct HasAllocatorType<
+    T, et::detail::meta::VoidType<typename T::allocator_type>>
+    : std::true_type {};
+
+}  // namespace
+
+TEST_CASE("Either of std::allocator payloads stays allocator free", "[pmr]") {
+  using Plain = et::Either<std::string, int>;
+  STATIC_REQUIRE_FALSE(HasAllocatorType<Plain>::value);
+  STATIC_REQUIRE_FALSE(std::uses_allocator<Plain, std::allocator<char>>::value);
+  STATIC_REQUIRE(sizeof(Plain) == sizeof(std::string) + alignof(std::string));
+}
+
+#if ET_HAS_PMR
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+// every allocation outside an arena throws
+class NoDefaultResource {
+ public:
+  NoDefaultResource()
+      : previous_(
+            std::pmr::set_default_resource(std::pmr::null_memory_resource())) {}
+
+  NoDefaultResource(NoDefaultResource const&) = delete;
+  NoDefaultResource& operator=(NoDefaultResource const&) = delete;
+
+  ~NoDefaultResource() { std::pmr::set_default_resource(previous_); }
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+
+// fixed buffer arena without upstream, so overflowing it throws too
+class Arena {
+ public:
+  Arena()
+      : resource_(buffer_.data(), buffer_.size(),
+                  std::pmr::null_memory_resource()) {}
+
+  auto Resource() noexcept -> std::pmr::memory_resource* {
+    return &resource_;
+  }
+
+ private:
+  std::array<std::byte, 8192> buffer_;
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+using Result = et::pmr::Result<et::pmr::Vector<int>>;
+
+constexpr auto kLong = "a message too long for the small string buffer";
+
+}  // namespace
+
+TEST_CASE("pmr Either is allocator aware", "[pmr]") {
+  STATIC_REQUIRE(std::uses_allocator<Result, et::pmr::Allocator>::value);
+  using Message = et::Either<int, et::pmr::String>;
+  STATIC_REQUIRE(std::is_same<Message::allocator_type,
+                              et::pmr::String::allocator_type>::value);
+  STATIC_REQUIRE_FALSE(
+      std::uses_allocator<et::Either<int, int>, et::pmr::Allocator>::value);
+}
+
+TEST_CASE("pmr Either keeps its payload's resource", "[pmr][allocation]") {
+  NoDefaultResource const guard;
+  auto arena = Arena();
+  auto other = Arena();
+  auto const before = counting::ThreadAllocations();
+  {
+    auto result = Result(et::Error(et::pmr::String(kLong, arena.Resource())));
+    CHECK(result.get_allocator().resource() == arena.Resource());
+
+    // a change of state constructs the new payload from the same resource
+    result = et::Success(et::pmr::Vector<int>({1, 2, 3}, other.Resource()));
+    CHECK(result.Success().get_allocator().resource() == arena.Resource());
+    result = et::Error(et::pmr::String(kLong, other.Resource()));
+    CHECK(result.Error().get_allocator().resource() == arena.Resource());
+
+    // assignment does not propagate the resource of the source
+    auto const foreign =
+        Result(et::Success(et::pmr::Vector<int>({4, 5}, other.Resource())));
+    result = foreign;
+    CHECK(result.get_allocator().resource() == arena.Resource());
+    CHECK(result.Success().get_allocator().resource() == arena.Resource());
+    CHECK(result.Success() == foreign.Success());
+
+    // copies select the default resource as the pmr containers do, an
+    // allocator extended copy picks the arena
+    CHECK_THROWS_AS(Result(result), std::bad_alloc);
+    auto const copy = Result(std::allocator_arg, other.Resource(), result);
+    CHECK(copy.Success().get_allocator().resource() == other.Resource());
+
+    // moves take the resource along
+    auto moved = Result(std::move(result));
+    CHECK(moved.get_allocator().resource() == arena.Resource());
+    CHECK(moved.Success().size() == 2);
+    CHECK_FALSE(result.IsSuccess());
+    CHECK_FALSE(result.IsError());
+  }
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news == before.news);
+}
+
+TEST_CASE("pmr containers hand their resource down to Either",
+          "[pmr][allocation]") {
+  NoDefaultResource const guard;
+  auto arena = Arena();
+  auto other = Arena();
+  auto const before = counting::ThreadAllocations();
+  {
+    auto results = et::pmr::Vector<Result>(arena.Resource());
+    results.reserve(4);
+    results.push_back(et::Error(et::pmr::String(kLong, other.Resource())));
+    results.emplace_back(
+        et::Success(et::pmr::Vector<int>({1, 2}, other.Resource())));
+    results.push_back(results.front());
+    results.resize(4);
+    CHECK(results.back().IsEmpty());
+    results.back() = et::Error(et::pmr::String(kLong, other.Resource()));
+
+    for (auto const& result : results) {
+      CHECK(result.get_allocator().resource() == arena.Resource());
+    }
+    CHECK(results[1].Success().get_allocator().resource() == arena.Resource());
+    CHECK(results[2].Error() == kLong);
+  }
+  auto const after = counting::ThreadAllocations();
+  CHECK(after.news == before.news);
+}
+
+#endif  // ET_HAS_PMR
@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/ptr_either.hpp"
+
+namespace {
+
+struct Node {
+  Node(std::int32_t value, std::int32_t& counter) : val(value), alive(counter) {
+    ++alive;
+  }
+  ~Node() { --alive; }
+
+  std::int32_t val;
+  std::int32_t& alive;
+};
+
+struct Failure {
+  std::string what;
+};
+
+using Result = et::PtrEither<Node, Failure>;
+
+}  // namespace
+
+TEST_CASE("PtrEither is a single word", "[ptr_either][layout]") {
+  static_assert(sizeof(Result) == sizeof(void*), "");
+  static_assert(std::is_nothrow_move_constructible<Result>::value, "");
+  static_assert(!std::is_copy_constructible<Result>::value, "");
+}
+
+TEST_CASE("PtrEither success ownership", "[ptr_either][Success]") {
+  auto alive = 0;
+  {
+    auto node = Result(et::Success(std::make_unique<Node>(7, alive)));
+    CHECK(alive == 1);
+    CHECK(node);
+    CHECK(node.IsSuccess());
+    CHECK_FALSE(node.IsError());
+    CHECK(node.Success().val == 7);
+    CHECK_THROWS_AS(node.Error(), et::BadEitherAccess);
+
+    auto moved = std::move(node);
+    CHECK_FALSE(node.IsSuccess());
+    CHECK_FALSE(node.IsError());
+    CHECK(moved.Success().val == 7);
+    CHECK(alive == 1);
+  }
+  CHECK(alive == 0);
+}
+
+TEST_CASE("PtrEither error ownership", "[ptr_either][Error]") {
+  auto alive = 0;
+  auto failure = Result::MakeError(Failure{"no route"});
+  CHECK_FALSE(failure);
+  CHECK(failure.IsError());
+  CHECK(failure.Error().what == "no route");
+  CHECK_THROWS_AS(failure.Success(), et::BadEitherAccess);
+
+  failure = Result::MakeSuccess(3, alive);
+  CHECK(failure.IsSuccess());
+  CHECK(alive == 1);
+
+  failure = Result(et::Error(std::make_unique<Failure>(Failure{"again"})));
+  CHECK(alive == 0);
+  CHECK(failure.Error().what == "again");
+}
+
+TEST_CASE("PtrEither rvalue access releases ownership",
+          "[ptr_either][Success][Error]") {
+  auto alive = 0;
+  auto node = Result::MakeSuccess(11, alive);
+
+  auto const owned = std::move(node).Success();
+  CHECK(owned->val == 11);
+  CHECK_FALSE(node.IsSuccess());
+  CHECK(alive == 1);
+
+  auto failure = Result::MakeError(Failure{"gone"});
+  auto const error = std::move(failure).Error();
+  CHECK(error->what == "gone");
+  CHECK_FALSE(failure.IsError());
+}
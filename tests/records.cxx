@@ -0,0 +1,173 @@
+#include "records.hpp"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+using Kind = records::ParseError::Kind;
+
+auto Parse(std::string const& line) -> records::ParseResult {
+  return records::ParseLine(line.data(), line.data() + line.size());
+}
+
+auto ErrorOf(std::string const& line) -> records::ParseError {
+  auto const result = Parse(line);
+  REQUIRE(result.IsError());
+  return result.Error();
+}
+
+auto Signed(std::string const& text, std::int64_t& out) -> bool {
+  return records::detail::ParseSigned(
+      records::Field{text.data(), text.size()}, out);
+}
+
+// unlinked file holding content, closed on scope exit
+class TempFile {
+ public:
+  explicit TempFile(std::string const& content) {
+    char path[] = "/tmp/et_records_testXXXXXX";
+    fd_ = ::mkstemp(path);
+    REQUIRE(fd_ != -1);
+    ::unlink(path);
+    for (auto written = std::size_t(0); written < content.size();) {
+      auto const wrote = et::sys::Write(fd_, content.data() + written,
+                                        content.size() - written);
+      REQUIRE(wrote.IsSuccess());
+      written += static_cast<std::size_t>(wrote.Success());
+    }
+  }
+
+  TempFile(TempFile const&) = delete;
+  TempFile& operator=(TempFile const&) = delete;
+
+  ~TempFile() { ::close(fd_); }
+
+  auto Fd() const noexcept -> int { return fd_; }
+
+ private:
+  int fd_;
+};
+
+// one entry per line: the record id, or the error kind plus 1000
+auto ReadRange(TempFile const& file, std::uint64_t const begin,
+               std::uint64_t const end) -> std::vector<std::uint64_t> {
+  auto seen = std::vector<std::uint64_t>();
+  auto reader = records::ChunkReader(file.Fd(), begin, end);
+  auto const lines = reader.ForEach([&seen](records::ParseResult const& r) {
+    seen.push_back(r ? r.Success().id
+                     : 1000 + static_cast<std::uint64_t>(r.Error().kind));
+  });
+  REQUIRE(lines.IsSuccess());
+  CHECK(lines.Success() == seen.size());
+  return seen;
+}
+
+}  // namespace
+
+TEST_CASE("ParseLine reads the three columns", "[records][ParseLine]") {
+  auto const line = std::string("42\tcharlie\t-17");
+  auto const result = Parse(line);
+  REQUIRE(result.IsSuccess());
+  CHECK(result.Success().id == 42);
+  CHECK(std::string(result.Success().key.data, result.Success().key.size) ==
+        "charlie");
+  CHECK(result.Success().key.data == line.data() + 3);
+  CHECK(result.Success().amount == -17);
+
+  // an empty key is a field
+  CHECK(Parse("1\t\t0").IsSuccess());
+}
+
+TEST_CASE("ParseLine reports the failing column", "[records][ParseLine]") {
+  CHECK(ErrorOf("").kind == Kind::kMissingField);
+  CHECK(ErrorOf("").column == 1);
+  CHECK(ErrorOf("7").column == 1);
+  CHECK(ErrorOf("7\tkey").kind == Kind::kMissingField);
+  CHECK(ErrorOf("7\tkey").column == 2);
+
+  CHECK(ErrorOf("7\tkey\t1\textra").kind == Kind::kTooManyFields);
+  CHECK(ErrorOf("7\tkey\t1\textra").column == 3);
+  // a separator ending the line opens no fourth field
+  CHECK(Parse("7\tkey\t1\t").IsSuccess());
+
+  CHECK(ErrorOf("x7\tkey\t1").kind == Kind::kBadNumber);
+  CHECK(ErrorOf("x7\tkey\t1").column == 0);
+  CHECK(ErrorOf("-7\tkey\t1").column == 0);
+  CHECK(ErrorOf("7\tkey\tn/a").column == 2);
+  CHECK(ErrorOf("7\tkey\t").column == 2);
+}
+
+TEST_CASE("ParseSigned accepts exactly the int64 range but its minimum",
+          "[records][ParseSigned]") {
+  auto value = std::int64_t(1);
+  CHECK(Signed("0", value));
+  CHECK(value == 0);
+  CHECK(Signed("-0", value));
+  CHECK(value == 0);
+  CHECK(Signed("9223372036854775807", value));
+  CHECK(value == INT64_MAX);
+  CHECK(Signed("-9223372036854775807", value));
+  CHECK(value == -INT64_MAX);
+
+  CHECK_FALSE(Signed("", value));
+  CHECK_FALSE(Signed("-", value));
+  CHECK_FALSE(Signed("+1", value));
+  CHECK_FALSE(Signed("1-", value));
+  CHECK_FALSE(Signed("--1", value));
+  CHECK_FALSE(Signed("9223372036854775808", value));
+  // the magnitude does not fit, like any other 19 digit overflow
+  CHECK_FALSE(Signed("-9223372036854775808", value));
+  CHECK_FALSE(Signed("00000000000000000001", value));
+}
+
+TEST_CASE("ChunkReader ranges split the lines exactly once",
+          "[records][ChunkReader]") {
+  auto const content =
+      std::string("1\ta\t10\n22\tbb\t-3\n\n333\tc\tn/a\n4\td\t4\n5\te\t5");
+  TempFile const file(content);
+  auto const all = ReadRange(file, 0, content.size());
+  CHECK(all == std::vector<std::uint64_t>{
+                   1, 22, 1000 + static_cast<std::uint64_t>(
+                                     Kind::kMissingField),
+                   1000 + static_cast<std::uint64_t>(Kind::kBadNumber), 4,
+                   5});
+
+  // a line belongs to the range it starts in, wherever the split falls
+  for (auto split = std::uint64_t(0); split <= content.size(); ++split) {
+    auto lines = ReadRange(file, 0, split);
+    auto const rest = ReadRange(file, split, content.size());
+    lines.insert(lines.end(), rest.begin(), rest.end());
+    CHECK(lines == all);
+  }
+}
+
+TEST_CASE("ChunkReader reports an overlong line once and resumes",
+          "[records][ChunkReader]") {
+  auto const long_line =
+      std::string(records::ChunkReader::kChunkSize * 3 / 2, 'x');
+  auto const content = "1\ta\t1\n" + long_line + "\n2\tb\t2\n";
+  TempFile const file(content);
+  auto const too_long = 1000 + static_cast<std::uint64_t>(Kind::kLineTooLong);
+
+  CHECK(ReadRange(file, 0, content.size()) ==
+        std::vector<std::uint64_t>{1, too_long, 2});
+
+  // splits before, inside and right after the long line
+  auto const long_begin = std::uint64_t(6);
+  auto const long_end = long_begin + long_line.size() + 1;
+  for (auto const split : {long_begin, long_begin + 1,
+                           long_begin + records::ChunkReader::kChunkSize,
+                           long_end}) {
+    auto lines = ReadRange(file, 0, split);
+    auto const rest = ReadRange(file, split, content.size());
+    lines.insert(lines.end(), rest.begin(), rest.end());
+    CHECK(lines == std::vector<std::uint64_t>{1, too_long, 2});
+  }
+}
@@ -0,0 +1,182 @@
+#include "et/shared_result_table.hpp"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+struct Summary {
+  std::uint64_t records;
+  std::uint64_t checksum;  // always ~records, torn reads break it
+};
+
+enum class Code : std::uint16_t { kTimeout = 1, kCrashed = 2 };
+
+std::ostream& operator<<(std::ostream& os, Code const code) {
+  return os << "Code " << static_cast<int>(code);
+}
+
+using Table = et::SharedResultTable<Summary, Code>;
+using Kind = et::SharedTableError::Kind;
+
+auto MakeSummary(std::uint64_t const records) -> Summary {
+  return Summary{records, ~records};
+}
+
+// unique per test process, unlinked again on scope exit
+class ShmName {
+ public:
+  explicit ShmName(char const* tag)
+      : name_("/et_shared_table_" + std::to_string(::getpid()) + "_" + tag) {
+    ::shm_unlink(name_.c_str());
+  }
+
+  ShmName(ShmName const&) = delete;
+  ShmName& operator=(ShmName const&) = delete;
+
+  ~ShmName() { ::shm_unlink(name_.c_str()); }
+
+  auto Get() const noexcept -> char const* { return name_.c_str(); }
+
+ private:
+  std::string name_;
+};
+
+}  // namespace
+
+TEST_CASE("SharedResultTable publishes and reads slots",
+          "[shared_result_table]") {
+  ShmName const name("publish");
+  auto created = Table::Create(name.Get(), 4);
+  REQUIRE(created.IsSuccess());
+  auto& table = created.Success();
+  CHECK(table.Slots() == 4);
+  CHECK(table.Read(0).Error() == et::SharedSlotStatus::kEmpty);
+  CHECK_THROWS_AS(table.Read(4), std::out_of_range);
+
+  table.Publish(0, et::Success(MakeSummary(10)));
+  table.Publish(1, et::Error(Code::kTimeout));
+  table.Publish(1, et::Error(Code::kCrashed));
+
+  auto attached = Table::Attach(name.Get());
+  REQUIRE(attached.IsSuccess());
+  auto const& reader = attached.Success();
+  CHECK(reader.Slots() == 4);
+
+  auto const first = reader.Read(0);
+  REQUIRE(first.IsSuccess());
+  CHECK(first.Success().Success().records == 10);
+  CHECK(reader.Read(1).Success().Error() == Code::kCrashed);
+  CHECK(reader.Publications(1) == 2);
+  CHECK(reader.Read(2).Error() == et::SharedSlotStatus::kEmpty);
+
+  // an empty result is rejected without locking the slot
+  CHECK_THROWS_AS(table.Publish(2, Table::ResultType()), et::BadEitherAccess);
+  CHECK(reader.Read(2).Error() == et::SharedSlotStatus::kEmpty);
+  table.Publish(2, et::Success(MakeSummary(20)));
+  CHECK(reader.Read(2).Success().Success().records == 20);
+  CHECK(reader.Publications(2) == 1);
+}
+
+TEST_CASE("SharedResultTable attach fails fast on mismatches",
+          "[shared_result_table]") {
+  ShmName const name("mismatch");
+  REQUIRE(Table::Create(name.Get(), 2, 7).IsSuccess());
+
+  CHECK(Table::Create(name.Get(), 2).Error() ==
+        et::SharedTableError(et::Errno(EEXIST)));
+  CHECK(Table::Attach(name.Get(), 7).IsSuccess());
+  CHECK(Table::Attach(name.Get(), 8).Error().GetKind() ==
+        Kind::kSchemaMismatch);
+  CHECK(et::SharedResultTable<Summary, std::uint64_t>::Attach(name.Get(), 7)
+            .Error()
+            .GetKind() == Kind::kLayoutMismatch);
+
+  ShmName const missing("missing");
+  CHECK(Table::Attach(missing.Get()).Error() ==
+        et::SharedTableError(et::Errno(ENOENT)));
+
+  // a binary of another format version
+  auto const fd = ::shm_open(name.Get(), O_RDWR, 0);
+  REQUIRE(fd != -1);
+  auto* const header = static_cast<unsigned char*>(
+      ::mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  ::close(fd);
+  REQUIRE(header != MAP_FAILED);
+  auto const version = std::uint32_t(2);
+  std::memcpy(header + 8, &version, sizeof(version));
+  CHECK(Table::Attach(name.Get(), 7).Error().GetKind() ==
+        Kind::kVersionMismatch);
+  std::memcpy(header, "notatabl", 8);
+  CHECK(Table::Attach(name.Get(), 7).Error().GetKind() == Kind::kBadMagic);
+  ::munmap(header, 64);
+}
+
+TEST_CASE("SharedResultTable rejects half initialized regions",
+          "[shared_result_table]") {
+  ShmName const name("foreign");
+  auto const fd = ::shm_open(name.Get(), O_CREAT | O_RDWR, 0600);
+  REQUIRE(fd != -1);
+  CHECK(Table::Attach(name.Get()).Error().GetKind() == Kind::kTooSmall);
+  REQUIRE(::ftruncate(fd, 4096) == 0);
+  ::close(fd);
+  CHECK(Table::Attach(name.Get()).Error().GetKind() == Kind::kNotReady);
+}
+
+TEST_CASE("SharedResultTable is shared across processes",
+          "[shared_result_table]") {
+  constexpr auto kSlots = std::size_t(8);
+  constexpr auto kRounds = std::uint64_t(20000);
+  ShmName const name("fork");
+  auto created = Table::Create(name.Get(), kSlots);
+  REQUIRE(created.IsSuccess());
+  auto const& table = created.Success();
+
+  auto const child = ::fork();
+  REQUIRE(child != -1);
+  if (child == 0) {
+    // no Catch in the child, report through the exit code
+    auto attached = Table::Attach(name.Get());
+    if (!attached) {
+      ::_exit(1);
+    }
+    for (auto round = std::uint64_t(1); round <= kRounds; ++round) {
+      for (auto slot = std::size_t(0); slot < kSlots; ++slot) {
+        if (slot == 3 && round == kRounds) {
+          attached.Success().Publish(slot, et::Error(Code::kTimeout));
+        } else {
+          attached.Success().Publish(slot, et::Success(MakeSummary(round)));
+        }
+      }
+    }
+    ::_exit(0);
+  }
+
+  // read while the child writes: every result seen must be whole
+  auto torn = 0;
+  for (auto i = 0; i < 100000; ++i) {
+    auto const read = table.Read(static_cast<std::size_t>(i) % kSlots);
+    if (read.IsSuccess() && read.Success().IsSuccess()) {
+      auto const& summary = read.Success().Success();
+      torn += summary.checksum == ~summary.records ? 0 : 1;
+    }
+  }
+
+  auto status = 0;
+  REQUIRE(::waitpid(child, &status, 0) == child);
+  REQUIRE(WIFEXITED(status));
+  CHECK(WEXITSTATUS(status) == 0);
+  CHECK(torn == 0);
+
+  CHECK(table.Read(0).Success().Success().records == kRounds);
+  CHECK(table.Read(3).Success().Error() == Code::kTimeout);
+  CHECK(table.Publications(7) == kRounds);
+}
@@ -0,0 +1,201 @@
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "counting.hpp"
+#include "et/either.hpp"
+
+namespace {
+
+using Succ = counting::Tracked<struct SpecialSuccessTag>;
+using Err = counting::Tracked<struct SpecialErrorTag>;
+using Et = et::Either<Succ, Err>;
+
+void ResetCalls() {
+  Succ::Reset();
+  Err::Reset();
+}
+
+// a payload that can be copied but not assigned
+struct Fixed {
+  explicit Fixed(int v) noexcept : value(v) {}
+  Fixed(Fixed const&) = default;
+  Fixed& operator=(Fixed const&) = delete;
+
+  int value;
+};
+
+// a payload whose move may throw
+struct Throwing {
+  Throwing() = default;
+  Throwing(Throwing const&) {}
+  Throwing(Throwing&&) {}
+  Throwing& operator=(Throwing const&) { return *this; }
+  Throwing& operator=(Throwing&&) { return *this; }
+};
+
+}  // namespace
+
+// the special members exist exactly when both payloads support them
+static_assert(std::is_copy_constructible<Et>::value, "");
+static_assert(std::is_nothrow_move_constructible<Et>::value, "");
+static_assert(std::is_nothrow_copy_assignable<Et>::value, "");
+static_assert(
+    !std::is_copy_constructible<et::Either<std::unique_ptr<int>, int>>::value,
+    "");
+static_assert(
+    !std::is_copy_assignable<et::Either<int, std::unique_ptr<int>>>::value, "");
+static_assert(
+    std::is_move_assignable<et::Either<std::unique_ptr<int>, int>>::value, "");
+static_assert(!std::is_move_constructible<et::Either<int, std::mutex>>::value,
+              "");
+static_assert(std::is_copy_constructible<et::Either<Fixed, int>>::value, "");
+static_assert(!std::is_copy_assignable<et::Either<Fixed, int>>::value, "");
+static_assert(!std::is_move_assignable<et::Either<Fixed, int>>::value, "");
+static_assert(!std::is_nothrow_move_constructible<
+                  et::Either<std::string, Throwing>>::value,
+              "");
+
+TEST_CASE("Either copy construction copies the active payload",
+          "[either][special]") {
+  ResetCalls();
+  {
+    auto const success = Et(et::Success(Succ(1)));
+    auto const success_copy = success;
+    CHECK(success_copy.Success().Value() == 1);
+    CHECK(success.Success().Value() == 1);
+
+    auto const error = Et(et::Error(Err(2)));
+    auto const error_copy = error;
+    CHECK(error_copy.Error().Value() == 2);
+
+    auto const empty = Et();
+    auto const empty_copy = empty;
+    CHECK(empty_copy.IsEmpty());
+
+    CHECK(Succ::Stats().copy_ctor == 1);
+    CHECK(Err::Stats().copy_ctor == 1);
+  }
+  // every payload constructed was destroyed exactly once
+  auto const succ = Succ::Stats();
+  CHECK(succ.value_ctor + succ.copy_ctor + succ.move_ctor == succ.dtor);
+  auto const err = Err::Stats();
+  CHECK(err.value_ctor + err.copy_ctor + err.move_ctor == err.dtor);
+}
+
+TEST_CASE("Either move construction leaves the source empty",
+          "[either][special]") {
+  ResetCalls();
+  auto success = Et(et::Success(Succ(1)));
+  auto const dtors = Succ::Stats().dtor;
+  auto const moved = std::move(success);
+  CHECK(moved.Success().Value() == 1);
+  CHECK(success.IsEmpty());
+  // the moved from payload is destroyed, not left behind hollow
+  CHECK(Succ::Stats().dtor == dtors + 1);
+
+  auto error = Et(et::Error(Err(2)));
+  auto const moved_error = std::move(error);
+  CHECK(moved_error.Error().Value() == 2);
+  CHECK(error.IsEmpty());
+
+  auto empty = Et();
+  auto const moved_empty = std::move(empty);
+  CHECK(moved_empty.IsEmpty());
+  CHECK(empty.IsEmpty());
+}
+
+TEST_CASE("Either assignment assigns or replaces the payload",
+          "[either][special]") {
+  ResetCalls();
+  auto target = Et(et::Success(Succ(1)));
+  auto const other_success = Et(et::Success(Succ(2)));
+  auto const other_error = Et(et::Error(Err(3)));
+
+  // same alternative: the payload is assigned
+  target = other_success;
+  CHECK(target.Success().Value() == 2);
+  CHECK(Succ::Stats().copy_assign == 1);
+  CHECK(Succ::Stats().copy_ctor == 0);
+
+  // other alternative: the old payload is destroyed, the new one copied
+  auto const dtors = Succ::Stats().dtor;
+  target = other_error;
+  CHECK(target.Error().Value() == 3);
+  CHECK(Succ::Stats().dtor == dtors + 1);
+  CHECK(Err::Stats().copy_ctor == 1);
+  CHECK(Err::Stats().copy_assign == 0);
+
+  target = Et();
+  CHECK(target.IsEmpty());
+  target = other_success;
+  CHECK(target.Success().Value() == 2);
+  CHECK(Succ::Stats().copy_ctor == 1);
+
+  // self assignment keeps the payload
+  auto const& self = target;
+  target = self;
+  CHECK(target.Success().Value() == 2);
+  CHECK(Succ::Stats().copy_assign == 1);
+}
+
+TEST_CASE("Either move assignment leaves the source empty",
+          "[either][special]") {
+  ResetCalls();
+  auto target = Et(et::Success(Succ(1)));
+
+  auto same = Et(et::Success(Succ(2)));
+  target = std::move(same);
+  CHECK(target.Success().Value() == 2);
+  CHECK(Succ::Stats().move_assign == 1);
+  CHECK(same.IsEmpty());
+
+  auto other = Et(et::Error(Err(3)));
+  auto const moves = Err::Stats().move_ctor;
+  target = std::move(other);
+  CHECK(target.Error().Value() == 3);
+  CHECK(Err::Stats().move_ctor == moves + 1);
+  CHECK(Err::Stats().move_assign == 0);
+  CHECK(other.IsEmpty());
+
+  auto empty = Et();
+  target = std::move(empty);
+  CHECK(target.IsEmpty());
+  CHECK(empty.IsEmpty());
+
+  auto owner = et::Either<std::unique_ptr<int>, int>(
+      et::Success(std::make_unique<int>(4)));
+  auto owner_target = et::Either<std::unique_ptr<int>, int>(et::Error(5));
+  owner_target = std::move(owner);
+  CHECK(*owner_target.Success() == 4);
+  CHECK(owner.IsEmpty());
+}
+
+TEST_CASE("Either with trivially copyable payloads moves as a copy",
+          "[either][special]") {
+  using Plain = et::Either<std::int32_t, std::int32_t>;
+  static_assert(std::is_trivially_copyable<Plain>::value, "");
+
+  auto success = Plain(et::Success(1));
+  auto const moved = std::move(success);
+  CHECK(moved.Success() == 1);
+  // the source is not emptied, unlike with non trivial payloads
+  CHECK(success.IsSuccess());
+  CHECK(success.Success() == 1);
+
+  auto error = Plain(et::Error(2));
+  auto target = Plain(et::Success(3));
+  target = std::move(error);
+  CHECK(target.Error() == 2);
+  CHECK(error.IsError());
+  CHECK(error.Error() == 2);
+
+  auto empty = Plain();
+  target = std::move(empty);
+  CHECK(target.IsEmpty());
+  CHECK(empty.IsEmpty());
+}
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/static_error.hpp"
+
+namespace {
+
+ET_DEFINE_STATIC_ERROR(kNotFound, 404, et::ErrorSeverity::kError,
+                       "[storage::Load] error: key not found");
+ET_DEFINE_STATIC_ERROR(kTimeout, 408, et::ErrorSeverity::kWarning,
+                       "[storage::Load] error: timed out");
+
+auto Load(std::int32_t key) -> et::Either<std::int32_t, et::StaticError> {
+  if (key < 0) {
+    return et::Error(kNotFound);
+  }
+  if (key == 0) {
+    return et::Error(
+        ET_STATIC_ERROR(1, et::ErrorSeverity::kFatal, "[storage::Load] zero"));
+  }
+  return et::Success(key);
+}
+
+}  // namespace
+
+TEST_CASE("StaticError is a single pointer", "[static_error][layout]") {
+  static_assert(sizeof(et::StaticError) == sizeof(void*), "");
+  static_assert(std::is_trivially_copyable<et::StaticError>::value, "");
+  static_assert(std::is_trivially_copyable<
+                    et::Either<std::int32_t, et::StaticError>>::value,
+                "");
+}
+
+TEST_CASE("StaticError constexpr descriptor access",
+          "[static_error][constexpr]") {
+  static_assert(kNotFound.Id() == 404, "");
+  static_assert(kNotFound.Severity() == et::ErrorSeverity::kError, "");
+  static_assert(kNotFound == kNotFound, "");
+  static_assert(kNotFound != kTimeout, "");
+
+  CHECK(std::string(kTimeout.Message()) == "[storage::Load] error: timed out");
+}
+
+TEST_CASE("StaticError equality by descriptor", "[static_error][Either]") {
+  CHECK(Load(-1).Error() == kNotFound);
+  CHECK(Load(-2).Error() == Load(-1).Error());
+  CHECK(Load(0).Error() == Load(0).Error());
+  CHECK(Load(0).Error() != kNotFound);
+  CHECK(Load(0).Error().Id() == 1);
+  CHECK(std::hash<et::StaticError>()(Load(-1).Error()) ==
+        std::hash<et::StaticError>()(kNotFound));
+}
+
+TEST_CASE("StaticError printing", "[static_error][print]") {
+  auto os = std::ostringstream();
+  os << Load(-1);
+  CHECK(os.str() == "error #404: [storage::Load] error: key not found");
+}
@@ -0,0 +1,63 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/sys.hpp"
+
+TEST_CASE("Errno value semantics", "[sys][Errno]") {
+  auto constexpr err = et::Errno(ENOENT);
+
+  static_assert(err.Value() == ENOENT, "");
+  static_assert(err == et::Errno(ENOENT), "");
+  static_assert(err != et::Errno(EBADF), "");
+
+  CHECK_FALSE(err.Message().empty());
+}
+
+TEST_CASE("sys wrappers report success values",
+          "[sys][Open][Write][Pread][Close]") {
+  char path[] = "/tmp/et_sys_testXXXXXX";
+  auto const fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  ::unlink(path);
+
+  auto const payload = std::string("either");
+  auto const written = et::sys::Write(fd, payload.data(), payload.size());
+  REQUIRE(written.IsSuccess());
+  CHECK(written.Success() == static_cast<::ssize_t>(payload.size()));
+
+  auto buf = std::string(payload.size(), '\0');
+  auto const read = et::sys::Pread(fd, &buf[0], buf.size(), 0);
+  REQUIRE(read.IsSuccess());
+  CHECK(read.Success() == static_cast<::ssize_t>(payload.size()));
+  CHECK(buf == payload);
+
+  auto const st = et::sys::Fstat(fd);
+  REQUIRE(st.IsSuccess());
+  CHECK(st.Success().st_size == static_cast<::off_t>(payload.size()));
+
+  CHECK(et::sys::Close(fd).IsSuccess());
+}
+
+TEST_CASE("sys wrappers capture errno on failure",
+          "[sys][Open][Read][Close][Mmap]") {
+  auto const opened = et::sys::Open("/nonexistent/et/path", O_RDONLY);
+  REQUIRE(opened.IsError());
+  CHECK(opened.Error() == et::Errno(ENOENT));
+
+  char buf[8];
+  auto const read = et::sys::Read(-1, buf, sizeof(buf));
+  REQUIRE(read.IsError());
+  CHECK(read.Error() == et::Errno(EBADF));
+
+  auto const mapped =
+      et::sys::Mmap(nullptr, 4096, PROT_READ, MAP_PRIVATE, -1, 0);
+  REQUIRE(mapped.IsError());
+  CHECK(mapped.Error() == et::Errno(EBADF));
+
+  CHECK(et::sys::Close(-1).Error() == et::Errno(EBADF));
+}
@@ -1,5 +1,9 @@
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 #include "et/either.hpp"
@@ -168,3 +172,95 @@ TEST_CASE("Either assignment move 2", "[either][constexpr][assignment]") {
   CHECK_FALSE(et1.IsSuccess());
   CHECK_FALSE(et1.IsError());
 }
+
+TEST_CASE("Either copy keeps source intact", "[either][copy]") {
+  auto const et_val = std::string("HelloHelloHelloHelloHelloHelloHello");
+  auto const et1 = et::Either<std::string, std::int32_t>(et::Success(et_val));
+
+  auto et2 = et1;
+  CHECK(et2.Success() == et_val);
+  CHECK(et1.Success() == et_val);
+
+  et2 = et::Either<std::string, std::int32_t>(et::Error(42));
+  CHECK(et2.Error() == 42);
+
+  et2 = et1;
+  CHECK(et2.Success() == et_val);
+}
+
+TEST_CASE("Either empty construction", "[either][empty]") {
+  using Et = et::Either<std::string, std::int32_t>;
+  static_assert(std::is_nothrow_default_constructible<Et>::value, "");
+  static_assert(
+      !std::is_default_constructible<et::Either<std::int32_t, void>>::value,
+      "");
+
+  auto et1 = Et();
+  CHECK(et1.IsEmpty());
+  CHECK_FALSE(et1);
+  CHECK_FALSE(et1.IsError());
+  CHECK_THROWS_AS(et1.Success(), et::BadEitherAccess);
+  CHECK_THROWS_AS(et1.Error(), et::BadEitherAccess);
+  CHECK(et1 == Et(et::empty));
+
+  et1 = et::Success(std::string("HelloHelloHelloHelloHelloHelloHello"));
+  CHECK_FALSE(et1.IsEmpty());
+  CHECK(et1 != Et(et::empty));
+
+  // empty is where a move leaves the source
+  auto const et2 = std::move(et1);
+  CHECK(et1.IsEmpty());
+  et1 = et::empty;
+  CHECK(et1.IsEmpty());
+  CHECK(et2.IsSuccess());
+}
+
+TEST_CASE("Either result buffer filled in parallel", "[either][empty]") {
+  using Et = et::Either<std::string, std::int32_t>;
+  constexpr auto kThreads = 4;
+  constexpr auto kSlots = std::size_t(1000);
+
+  auto results = std::vector<Et>(kThreads * kSlots);
+  auto batch = std::make_unique<Et[]>(kThreads * kSlots);
+  auto threads = std::vector<std::thread>();
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&results, &batch, t] {
+      auto const first = static_cast<std::size_t>(t) * kSlots;
+      for (auto i = first; i < first + kSlots; ++i) {
+        if (i % 3 == 0) {
+          results[i] = et::Error(static_cast<std::int32_t>(i));
+        } else {
+          results[i] = et::Success(std::to_string(i));
+        }
+        batch[i] = results[i];
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto mismatches = 0;
+  for (auto i = std::size_t(0); i < results.size(); ++i) {
+    auto const expected =
+        i % 3 == 0 ? Et(et::Error(static_cast<std::int32_t>(i)))
+                   : Et(et::Success(std::to_string(i)));
+    mismatches += results[i] == expected && batch[i] == expected ? 0 : 1;
+  }
+  CHECK(mismatches == 0);
+}
+
+TEST_CASE("Either std::hash", "[either][hash]") {
+  using Et = et::Either<std::int32_t, std::int32_t>;
+  auto const hash = std::hash<Et>();
+
+  CHECK(hash(Et(et::Success(1))) == hash(Et(et::Success(1))));
+  CHECK(hash(Et(et::Error(1))) == hash(Et(et::Error(1))));
+  CHECK(hash(Et(et::Success(1))) != hash(Et(et::Error(1))));
+  CHECK(std::hash<et::Either<std::int32_t, void>>()(et::Success(1)) ==
+        hash(Et(et::Success(1))));
+
+  using NotHashable = et::Either<std::int32_t, et::detail::asserts::NoCopyMove>;
+  static_assert(
+      !std::is_default_constructible<std::hash<NotHashable>>::value, "");
+}
@@ -0,0 +1,141 @@
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "et/uring.hpp"
+
+#if ET_HAS_URING
+
+namespace {
+
+auto TempFile(std::string const& content) -> int {
+  char path[] = "/tmp/et_uring_testXXXXXX";
+  auto const fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  ::unlink(path);
+  REQUIRE(et::sys::Write(fd, content.data(), content.size()).IsSuccess());
+  return fd;
+}
+
+}  // namespace
+
+TEST_CASE("Ring batch read yields Either per completion",
+          "[uring][SubmitBatch][Wait][Reap]") {
+  auto ring = et::uring::Ring::Create(8);
+  REQUIRE(ring.IsSuccess());
+  auto r = std::move(ring).Success();
+
+  auto const content = std::string("0123456789abcdef");
+  auto const fd = TempFile(content);
+
+  auto bufs = std::array<std::array<char, 4>, 3>{};
+  auto const ops = std::vector<et::uring::Op>{
+      et::uring::Op::Read(fd, bufs[0].data(), 4, 0, 0),
+      et::uring::Op::Read(fd, bufs[1].data(), 4, 8, 1),
+      et::uring::Op::Read(-1, bufs[2].data(), 4, 0, 2),
+  };
+
+  auto const submitted = r.SubmitBatch(ops);
+  REQUIRE(submitted.IsSuccess());
+  CHECK(submitted.Success() == ops.size());
+
+  auto const ready = r.Wait(ops.size());
+  REQUIRE(ready.IsSuccess());
+  CHECK(ready.Success() == ops.size());
+
+  auto completed = 0;
+  auto const reaped = r.Reap([&](et::uring::Completion const& c) {
+    ++completed;
+    if (c.user_data == 2) {
+      REQUIRE(c.result.IsError());
+      CHECK(c.result.Error() == et::Errno(EBADF));
+    } else {
+      REQUIRE(c.result.IsSuccess());
+      CHECK(c.result.Success() == 4);
+    }
+  });
+
+  CHECK(reaped == ops.size());
+  CHECK(completed == 3);
+  CHECK(r.Ready() == 0);
+  CHECK(std::string(bufs[0].data(), 4) == "0123");
+  CHECK(std::string(bufs[1].data(), 4) == "89ab");
+
+  ::close(fd);
+}
+
+TEST_CASE("Ring reads into registered buffers", "[uring][RegisterBuffers]") {
+  auto ring = et::uring::Ring::Create(4);
+  REQUIRE(ring.IsSuccess());
+  auto r = std::move(ring).Success();
+
+  auto const fd = TempFile("registered");
+  auto buf = std::array<char, 16>{};
+  auto const iov = ::iovec{buf.data(), buf.size()};
+  REQUIRE(r.RegisterBuffers(&iov, 1).IsSuccess());
+
+  auto const op = et::uring::Op::Read(fd, buf.data(), 10, 0, 7)
+                      .WithFixedBuffer(0);
+  REQUIRE(r.SubmitBatch(&op, 1).IsSuccess());
+  REQUIRE(r.Wait(1).IsSuccess());
+
+  r.Reap([](et::uring::Completion const& c) {
+    CHECK(c.user_data == 7);
+    REQUIRE(c.result.IsSuccess());
+    CHECK(c.result.Success() == 10);
+  });
+  CHECK(std::string(buf.data(), 10) == "registered");
+
+  CHECK(r.UnregisterBuffers().IsSuccess());
+  ::close(fd);
+}
+
+TEST_CASE("Ring submits a batch larger than its queue in parts",
+          "[uring][SubmitBatch]") {
+  auto ring = et::uring::Ring::Create(4);
+  REQUIRE(ring.IsSuccess());
+  auto r = std::move(ring).Success();
+  REQUIRE(r.Capacity() == 4);
+
+  auto const content = std::string("0123456789");
+  auto const fd = TempFile(content);
+  auto bufs = std::array<char, 10>{};
+  auto ops = std::vector<et::uring::Op>();
+  for (auto i = std::uint32_t(0); i < 10; ++i) {
+    ops.push_back(et::uring::Op::Read(fd, &bufs[i], 1, i, i));
+  }
+
+  // each call takes what fits, the rest is resubmitted from where it stopped
+  auto next = std::size_t(0);
+  auto seen = std::vector<std::uint64_t>();
+  while (next < ops.size()) {
+    auto const submitted = r.SubmitBatch(ops.data() + next, ops.size() - next);
+    REQUIRE(submitted.IsSuccess());
+    CHECK(submitted.Success() == std::min<std::size_t>(4, ops.size() - next));
+    REQUIRE(r.Wait(submitted.Success()).IsSuccess());
+    auto const reaped = r.Reap([&](et::uring::Completion const& c) {
+      REQUIRE(c.result.IsSuccess());
+      seen.push_back(c.user_data);
+    });
+    CHECK(reaped == submitted.Success());
+    next += submitted.Success();
+  }
+
+  CHECK(seen.size() == ops.size());
+  CHECK(std::string(bufs.data(), bufs.size()) == content);
+  // nothing was left queued behind the last batch
+  CHECK(r.SubmitBatch(ops.data(), 0).Success() == 0);
+  CHECK(r.Ready() == 0);
+
+  ::close(fd);
+}
+
+#endif  // ET_HAS_URING
@@ -0,0 +1,43 @@
+// Prints the entries of an et::Journal file, oldest first:
+//
+//   et_journal_dump <journal> [count]
+//
+// count limits the output to the newest entries. The file may still be
+// mapped by a live process or left behind by a crashed one.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "et/journal.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "usage: " << argv[0] << " <journal> [count]\n";
+    return 2;
+  }
+
+  auto const reader = et::JournalReader::Open(argv[1]);
+  if (!reader) {
+    std::cerr << argv[1] << ": " << reader.Error() << '\n';
+    return 1;
+  }
+
+  auto const records = reader.Success().Records();
+  auto first = std::size_t(0);
+  if (argc == 3) {
+    auto const count = std::strtoull(argv[2], nullptr, 10);
+    if (count < records.size()) {
+      first = records.size() - static_cast<std::size_t>(count);
+    }
+  }
+
+  std::cout << "# capacity " << reader.Success().Capacity() << " appended "
+            << reader.Success().Appended() << " readable " << records.size()
+            << '\n'
+            << "# time_ns thread site outcome payload\n";
+  for (auto i = first; i < records.size(); ++i) {
+    std::cout << records[i] << '\n';
+  }
+  return 0;
+}